@@ -54,6 +54,12 @@ TEST_NAMES = \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
+	TestWindowStatistics \
+	TestOpenHash \
+	TestPortLineSplitter \
+	TestLockFreeFifo \
+	TestStageProfiler \
+	TestLabelBlock \
 	TestDateTime \
 	TestMathTables \
 	TestAngle TestUnits TestEarth TestSunEphemeris \
@@ -65,7 +71,7 @@ TEST_NAMES = \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
 	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
-	TestPlanes
+	TestPlanes TestRoutePlanner
 
 TESTS = $(patsubst %,$(TARGET_BIN_DIR)/%$(TARGET_EXEEXT),$(TEST_NAMES))
 
@@ -78,6 +84,68 @@ $(TARGET_BIN_DIR)/TestOverwritingRingBuffer$(TARGET_EXEEXT): $(TEST_TEST_OVERWRI
 	@$(NQ)echo "  LINK    $@"
 	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
 
+TEST_WINDOW_STATISTICS_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWindowStatistics.cpp
+TEST_WINDOW_STATISTICS_OBJS = $(call SRC_TO_OBJ,$(TEST_WINDOW_STATISTICS_SOURCES))
+TEST_WINDOW_STATISTICS_LDADD = $(MATH_LIBS)
+$(TARGET_BIN_DIR)/TestWindowStatistics$(TARGET_EXEEXT): $(TEST_WINDOW_STATISTICS_OBJS) $(TEST_WINDOW_STATISTICS_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
+
+TEST_STAGE_PROFILER_SOURCES = \
+	$(SRC)/StageProfiler.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/Thread/Debug.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestStageProfiler.cpp
+TEST_STAGE_PROFILER_OBJS = $(call SRC_TO_OBJ,$(TEST_STAGE_PROFILER_SOURCES))
+TEST_STAGE_PROFILER_LDADD = $(MATH_LIBS)
+$(TARGET_BIN_DIR)/TestStageProfiler$(TARGET_EXEEXT): $(TEST_STAGE_PROFILER_OBJS) $(TEST_STAGE_PROFILER_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
+
+TEST_LABEL_BLOCK_SOURCES = \
+	$(SRC)/Screen/LabelBlock.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLabelBlock.cpp
+TEST_LABEL_BLOCK_OBJS = $(call SRC_TO_OBJ,$(TEST_LABEL_BLOCK_SOURCES))
+TEST_LABEL_BLOCK_LDADD = $(MATH_LIBS)
+$(TEST_LABEL_BLOCK_OBJS): CPPFLAGS += $(SCREEN_CPPFLAGS)
+$(TARGET_BIN_DIR)/TestLabelBlock$(TARGET_EXEEXT): $(TEST_LABEL_BLOCK_OBJS) $(TEST_LABEL_BLOCK_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
+
+TEST_OPEN_HASH_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestOpenHash.cpp
+TEST_OPEN_HASH_OBJS = $(call SRC_TO_OBJ,$(TEST_OPEN_HASH_SOURCES))
+TEST_OPEN_HASH_LDADD = $(MATH_LIBS)
+$(TARGET_BIN_DIR)/TestOpenHash$(TARGET_EXEEXT): $(TEST_OPEN_HASH_OBJS) $(TEST_OPEN_HASH_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
+
+TEST_PORT_LINE_SPLITTER_SOURCES = \
+	$(SRC)/Device/PortLineSplitter.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestPortLineSplitter.cpp
+TEST_PORT_LINE_SPLITTER_OBJS = $(call SRC_TO_OBJ,$(TEST_PORT_LINE_SPLITTER_SOURCES))
+TEST_PORT_LINE_SPLITTER_LDADD = $(MATH_LIBS)
+$(TARGET_BIN_DIR)/TestPortLineSplitter$(TARGET_EXEEXT): $(TEST_PORT_LINE_SPLITTER_OBJS) $(TEST_PORT_LINE_SPLITTER_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
+
+TEST_LOCK_FREE_FIFO_SOURCES = \
+	$(SRC)/Thread/Thread.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestLockFreeFifo.cpp
+TEST_LOCK_FREE_FIFO_OBJS = $(call SRC_TO_OBJ,$(TEST_LOCK_FREE_FIFO_SOURCES))
+TEST_LOCK_FREE_FIFO_LDADD = $(MATH_LIBS)
+$(TARGET_BIN_DIR)/TestLockFreeFifo$(TARGET_EXEEXT): $(TEST_LOCK_FREE_FIFO_OBJS) $(TEST_LOCK_FREE_FIFO_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
+
 TEST_DATE_TIME_SOURCES = \
 	$(SRC)/DateTime.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -177,6 +245,7 @@ TEST_ROUTE_SOURCES = \
 	$(SRC)/OS/PathName.cpp \
 	$(SRC)/Engine/Math/Earth.cpp \
 	$(SRC)/Operation.cpp \
+	$(SRC)/OS/Clock.cpp \
 	$(TEST_SRC_DIR)/test_route.cpp
 TEST_ROUTE_OBJS = $(call SRC_TO_OBJ,$(TEST_ROUTE_SOURCES))
 TEST_ROUTE_BIN = $(TARGET_BIN_DIR)/test_route$(TARGET_EXEEXT)
@@ -190,6 +259,30 @@ $(TEST_ROUTE_BIN): $(TEST_ROUTE_OBJS) $(TEST_ROUTE_LDADD) | $(TARGET_BIN_DIR)/di
 	@$(NQ)echo "  LINK    $@"
 	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) $(ZZIP_LDFLAGS) $(ZZIP_LIBS) -o $@
 
+TEST_ROUTE_PLANNER_SOURCES = \
+	$(SRC)/Terrain/RasterTile.cpp \
+	$(SRC)/Terrain/RasterMap.cpp \
+	$(SRC)/Terrain/RasterBuffer.cpp \
+	$(SRC)/Terrain/RasterProjection.cpp \
+	$(SRC)/Geo/GeoClip.cpp \
+	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/PathName.cpp \
+	$(SRC)/Engine/Math/Earth.cpp \
+	$(SRC)/Operation.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestRoutePlanner.cpp
+TEST_ROUTE_PLANNER_OBJS = $(call SRC_TO_OBJ,$(TEST_ROUTE_PLANNER_SOURCES))
+TEST_ROUTE_PLANNER_LDADD = $(ENGINE_CORE_LIBS) \
+	$(MATH_LIBS) \
+	$(IO_LIBS) \
+	$(UTIL_LIBS) \
+	$(JASPER_LIBS) \
+	$(ZZIP_LIBS) \
+	$(COMPAT_LIBS)
+$(TARGET_BIN_DIR)/TestRoutePlanner$(TARGET_EXEEXT): $(TEST_ROUTE_PLANNER_OBJS) $(TEST_ROUTE_PLANNER_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) $(ZZIP_LDFLAGS) $(ZZIP_LIBS) -o $@
+
 TEST_REPLAY_TASK_SOURCES = \
 	$(SRC)/Engine/Util/DataNodeXML.cpp \
 	$(SRC)/xmlParser.cpp \
@@ -472,6 +565,7 @@ $(TARGET_BIN_DIR)/TestRadixTree$(TARGET_EXEEXT): $(TEST_RADIX_TREE_OBJS) | $(TAR
 
 TEST_LOGGER_SOURCES = \
 	$(SRC)/Logger/IGCWriter.cpp \
+	$(SRC)/Thread/Thread.cpp \
 	$(SRC)/Logger/LoggerFRecord.cpp \
 	$(SRC)/Logger/LoggerGRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
@@ -551,12 +645,14 @@ $(TARGET_BIN_DIR)/TestDriver$(TARGET_EXEEXT): $(TEST_DRIVER_OBJS) $(TEST_DRIVER_
 TEST_WAY_POINT_FILE_SOURCES = \
 	$(SRC)/Units/Units.cpp \
 	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/PathName.cpp \
 	$(SRC)/UtilsFile.cpp \
 	$(SRC)/Poco/RWLock.cpp \
 	$(SRC)/Thread/Debug.cpp \
 	$(SRC)/Thread/Mutex.cpp \
 	$(SRC)/Geo/UTM.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
 	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
@@ -629,20 +725,78 @@ $(TARGET_BIN_DIR)/FlightTable$(TARGET_EXEEXT): $(FLIGHT_TABLE_OBJS) $(FLIGHT_TAB
 	@$(NQ)echo "  LINK    $@"
 	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
 
+RUN_BATCH_ANALYSIS_SOURCES = \
+	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/PathName.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/Thread/Debug.cpp \
+	$(SRC)/Replay/IGCParser.cpp \
+	$(SRC)/Engine/Util/DataNodeXML.cpp \
+	$(SRC)/xmlParser.cpp \
+	$(SRC)/Compatibility/string.c \
+	$(TEST_SRC_DIR)/RunBatchAnalysis.cpp
+RUN_BATCH_ANALYSIS_OBJS = $(call SRC_TO_OBJ,$(RUN_BATCH_ANALYSIS_SOURCES))
+RUN_BATCH_ANALYSIS_LDADD = $(ENGINE_CORE_LIBS) $(IO_LIBS) $(UTIL_LIBS) $(MATH_LIBS)
+$(TARGET_BIN_DIR)/RunBatchAnalysis$(TARGET_EXEEXT): $(RUN_BATCH_ANALYSIS_OBJS) $(RUN_BATCH_ANALYSIS_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
+
+RUN_CONTEST_SCORE_SOURCES = \
+	$(SRC)/OS/Clock.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/Thread/Debug.cpp \
+	$(SRC)/Replay/IGCParser.cpp \
+	$(TEST_SRC_DIR)/RunContestScore.cpp
+RUN_CONTEST_SCORE_OBJS = $(call SRC_TO_OBJ,$(RUN_CONTEST_SCORE_SOURCES))
+RUN_CONTEST_SCORE_LDADD = $(ENGINE_CORE_LIBS) $(IO_LIBS) $(UTIL_LIBS) $(MATH_LIBS)
+$(TARGET_BIN_DIR)/RunContestScore$(TARGET_EXEEXT): $(RUN_CONTEST_SCORE_OBJS) $(RUN_CONTEST_SCORE_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
+
 build-check: $(TESTS)
 
 check: $(TESTS) | $(OUT)/test/dirstamp
 	@$(NQ)echo "  TEST    $(notdir $(patsubst %$(TARGET_EXEEXT),%,$^))"
 	$(Q)$(PERL) $(TEST_SRC_DIR)/testall.pl $(TESTS)
 
+# The baseline is specific to one machine and one build configuration
+# (the checksums differ with FIXED, the timings with DEBUG), so it is
+# kept in the output directory, one for each configuration.  Generate
+# it with "make benchmark-baseline" before measuring a change.
+BENCHMARK_BASELINE = $(TARGET_OUTPUT_DIR)/benchmark-baseline-fixed-$(FIXED)-debug-$(DEBUG).txt
+BENCHMARK_TOLERANCE = 10
+BENCHMARK_ARGS = \
+	-t $(topdir)/test/data/benalla9.xcm \
+	-f $(topdir)/test/data/01lz1hq1.igc
+
+benchmark: $(TARGET_BIN_DIR)/BenchmarkEngine$(TARGET_EXEEXT)
+ifeq ($(DEBUG),y)
+	@echo "warning: benchmarking a debug build, timings are not representative; use DEBUG=n" >&2
+endif
+	@$(NQ)echo "  BENCH   $(notdir $(BENCHMARK_BASELINE))"
+	$(Q)$(PERL) $(TEST_SRC_DIR)/benchmark.pl \
+		--tolerance=$(BENCHMARK_TOLERANCE) $(BENCHMARK_BASELINE) \
+		$< $(BENCHMARK_ARGS)
+
+benchmark-baseline: $(TARGET_BIN_DIR)/BenchmarkEngine$(TARGET_EXEEXT)
+ifeq ($(DEBUG),y)
+	@echo "warning: benchmarking a debug build, timings are not representative; use DEBUG=n" >&2
+endif
+	@$(NQ)echo "  BENCH   $(notdir $(BENCHMARK_BASELINE))"
+	$(Q)$(PERL) $(TEST_SRC_DIR)/benchmark.pl --update $(BENCHMARK_BASELINE) \
+		$< $(BENCHMARK_ARGS)
+
 DEBUG_PROGRAM_NAMES = \
 	test_reach \
 	test_route \
 	test_troute \
 	TestTrace \
 	FlightTable \
+	RunBatchAnalysis RunContestScore \
 	TestOLC \
-	BenchmarkProjection \
+	BenchmarkProjection BenchmarkEngine \
 	DumpTextFile DumpTextZip WriteTextFile RunTextWriter \
 	RunXMLParser \
 	ReadMO \
@@ -665,6 +819,7 @@ DEBUG_PROGRAM_NAMES = \
 	RunProgressWindow \
 	RunJobDialog \
 	RunAnalysis \
+	RunGlideComputer \
 	RunAirspaceWarningDialog \
 	TestNotify \
 	DebugDisplay
@@ -686,6 +841,7 @@ DEBUG_PROGRAMS = $(patsubst %,$(TARGET_BIN_DIR)/%$(TARGET_EXEEXT),$(DEBUG_PROGRA
 
 BENCHMARK_PROJECTION_SOURCES = \
 	$(SRC)/Projection.cpp \
+	$(SRC)/OS/Clock.cpp \
 	$(TEST_SRC_DIR)/BenchmarkProjection.cpp
 BENCHMARK_PROJECTION_OBJS = $(call SRC_TO_OBJ,$(BENCHMARK_PROJECTION_SOURCES))
 BENCHMARK_PROJECTION_LDADD = \
@@ -695,6 +851,31 @@ $(TARGET_BIN_DIR)/BenchmarkProjection$(TARGET_EXEEXT): $(BENCHMARK_PROJECTION_OB
 	@$(NQ)echo "  LINK    $@"
 	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) -o $@
 
+BENCHMARK_ENGINE_SOURCES = \
+	$(SRC)/Terrain/RasterTile.cpp \
+	$(SRC)/Terrain/RasterMap.cpp \
+	$(SRC)/Terrain/RasterBuffer.cpp \
+	$(SRC)/Terrain/RasterProjection.cpp \
+	$(SRC)/Geo/GeoClip.cpp \
+	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/PathName.cpp \
+	$(SRC)/OS/Clock.cpp \
+	$(SRC)/Engine/Math/Earth.cpp \
+	$(SRC)/Replay/IGCParser.cpp \
+	$(SRC)/Operation.cpp \
+	$(TEST_SRC_DIR)/BenchmarkEngine.cpp
+BENCHMARK_ENGINE_OBJS = $(call SRC_TO_OBJ,$(BENCHMARK_ENGINE_SOURCES))
+BENCHMARK_ENGINE_BIN = $(TARGET_BIN_DIR)/BenchmarkEngine$(TARGET_EXEEXT)
+BENCHMARK_ENGINE_LDADD = $(TESTLIBS1) \
+	$(MATH_LIBS) \
+	$(IO_LIBS) \
+	$(JASPER_LIBS) \
+	$(ZZIP_LIBS) \
+	$(COMPAT_LIBS)
+$(BENCHMARK_ENGINE_BIN): $(BENCHMARK_ENGINE_OBJS) $(BENCHMARK_ENGINE_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) $(ZZIP_LDFLAGS) $(ZZIP_LIBS) -o $@
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_OBJS = $(call SRC_TO_OBJ,$(DUMP_TEXT_FILE_SOURCES))
@@ -1000,6 +1181,7 @@ $(TARGET_BIN_DIR)/RunInputParser$(TARGET_EXEEXT): $(RUN_INPUT_PARSER_OBJS) $(RUN
 RUN_WAY_POINT_PARSER_SOURCES = \
 	$(SRC)/Geo/UTM.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
 	$(SRC)/Waypoint/WaypointReaderFS.cpp \
@@ -1059,6 +1241,8 @@ READ_PORT_SOURCES = \
 	$(TEST_SRC_DIR)/ReadPort.cpp
 ifeq ($(HAVE_POSIX),y)
 READ_PORT_SOURCES += \
+	$(SRC)/Device/IOThread.cpp \
+	$(SRC)/Device/PortLineSplitter.cpp \
 	$(SRC)/Device/TTYPort.cpp
 else
 READ_PORT_SOURCES += \
@@ -1084,6 +1268,8 @@ RUN_PORT_HANDLER_SOURCES = \
 	$(TEST_SRC_DIR)/RunPortHandler.cpp
 ifeq ($(HAVE_POSIX),y)
 RUN_PORT_HANDLER_SOURCES += \
+	$(SRC)/Device/IOThread.cpp \
+	$(SRC)/Device/PortLineSplitter.cpp \
 	$(SRC)/Device/TTYPort.cpp
 else
 RUN_PORT_HANDLER_SOURCES += \
@@ -1163,6 +1349,8 @@ RUN_DECLARE_SOURCES = \
 	$(TEST_SRC_DIR)/RunDeclare.cpp
 ifeq ($(HAVE_POSIX),y)
 RUN_DECLARE_SOURCES += \
+	$(SRC)/Device/IOThread.cpp \
+	$(SRC)/Device/PortLineSplitter.cpp \
 	$(SRC)/Device/TTYPort.cpp
 else
 RUN_DECLARE_SOURCES += \
@@ -1208,6 +1396,8 @@ RUN_FLIGHT_LIST_SOURCES = \
 	$(TEST_SRC_DIR)/RunFlightList.cpp
 ifeq ($(HAVE_POSIX),y)
 RUN_FLIGHT_LIST_SOURCES += \
+	$(SRC)/Device/IOThread.cpp \
+	$(SRC)/Device/PortLineSplitter.cpp \
 	$(SRC)/Device/TTYPort.cpp
 else
 RUN_FLIGHT_LIST_SOURCES += \
@@ -1253,6 +1443,8 @@ RUN_DOWNLOAD_FLIGHT_SOURCES = \
 	$(TEST_SRC_DIR)/RunDownloadFlight.cpp
 ifeq ($(HAVE_POSIX),y)
 RUN_DOWNLOAD_FLIGHT_SOURCES += \
+	$(SRC)/Device/IOThread.cpp \
+	$(SRC)/Device/PortLineSplitter.cpp \
 	$(SRC)/Device/TTYPort.cpp
 else
 RUN_DOWNLOAD_FLIGHT_SOURCES += \
@@ -1310,6 +1502,7 @@ RUN_IGC_WRITER_SOURCES = \
 	$(SRC)/Logger/LoggerGRecord.cpp \
 	$(SRC)/Logger/LoggerEPE.cpp \
 	$(SRC)/Logger/MD5.cpp \
+	$(SRC)/Thread/Thread.cpp \
 	$(SRC)/Compatibility/string.c \
 	$(SRC)/OS/Clock.cpp \
 	$(SRC)/Operation.cpp \
@@ -1431,8 +1624,10 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/MapWindow/MapWindowTask.cpp \
 	$(SRC)/MapWindow/MapWindowThermal.cpp \
 	$(SRC)/MapWindow/MapWindowTimer.cpp \
+	$(SRC)/MapWindow/MapRenderProfiler.cpp \
 	$(SRC)/MapWindow/MapWindowTraffic.cpp \
 	$(SRC)/MapWindow/MapWindowTrail.cpp \
+	$(SRC)/MapWindow/TrailRenderer.cpp \
 	$(SRC)/MapWindow/MapWindowWaypoints.cpp \
 	$(SRC)/MapWindow/MapCanvas.cpp \
 	$(SRC)/MapWindow/MapDrawHelper.cpp \
@@ -1477,6 +1672,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Thread/Debug.cpp \
 	$(SRC)/Thread/Mutex.cpp \
 	$(SRC)/Thread/Notify.cpp \
+	$(SRC)/Thread/Thread.cpp \
 	$(SRC)/Topography/TopographyFile.cpp \
 	$(SRC)/Topography/TopographyStore.cpp \
 	$(SRC)/Topography/TopographyRenderer.cpp \
@@ -1493,6 +1689,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
 	$(SRC)/Waypoint/WaypointReaderFS.cpp \
 	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
@@ -1738,6 +1935,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Thread/Debug.cpp \
 	$(SRC)/Thread/Mutex.cpp \
 	$(SRC)/Thread/Notify.cpp \
+	$(SRC)/Thread/Thread.cpp \
 	$(SRC)/Poco/RWLock.cpp \
 	$(SRC)/Profile/Profile.cpp \
 	$(SRC)/Profile/ProfileKeys.cpp \
@@ -1768,6 +1966,8 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/GlideComputerInterface.cpp \
 	$(SRC)/GlideComputerAirData.cpp \
 	$(SRC)/GlideComputerStats.cpp \
+	$(SRC)/StageProfiler.cpp \
+	$(SRC)/CalculationProfiler.cpp \
 	$(SRC)/SettingsComputer.cpp \
 	$(SRC)/Replay/IGCParser.cpp \
 	$(SRC)/SettingsComputerBlackboard.cpp \
@@ -1812,6 +2012,97 @@ $(RUN_ANALYSIS_BIN): $(RUN_ANALYSIS_OBJS) $(RUN_ANALYSIS_LDADD) | $(TARGET_BIN_D
 	@$(NQ)echo "  LINK    $@"
 	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) $(PROFILE_LDLIBS) $(ZZIP_LDFLAGS) -o $@
 
+RUN_GLIDE_COMPUTER_SOURCES = \
+	$(SRC)/DateTime.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/MoreData.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/Derived.cpp \
+	$(SRC)/NMEA/VarioInfo.cpp \
+	$(SRC)/NMEA/ClimbInfo.cpp \
+	$(SRC)/NMEA/CirclingInfo.cpp \
+	$(SRC)/NMEA/ThermalBand.cpp \
+	$(SRC)/NMEA/ThermalLocator.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/NMEA/ClimbHistory.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/FLARM/State.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/FlarmCalculations.cpp \
+	$(SRC)/ClimbAverageCalculator.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/OS/PathName.cpp \
+	$(SRC)/OS/FileUtil.cpp \
+	$(SRC)/OS/Clock.cpp \
+	$(SRC)/UtilsFile.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Wind/WindAnalyser.cpp \
+	$(SRC)/Wind/WindStore.cpp \
+	$(SRC)/Wind/WindMeasurementList.cpp \
+	$(SRC)/Wind/WindZigZag.cpp \
+	$(SRC)/Units/Units.cpp \
+	$(SRC)/Thread/Debug.cpp \
+	$(SRC)/Thread/Mutex.cpp \
+	$(SRC)/Thread/Thread.cpp \
+	$(SRC)/Poco/RWLock.cpp \
+	$(SRC)/Terrain/RasterBuffer.cpp \
+	$(SRC)/Terrain/RasterProjection.cpp \
+	$(SRC)/Terrain/RasterTile.cpp \
+	$(SRC)/Terrain/RasterMap.cpp \
+	$(SRC)/Geo/GeoClip.cpp \
+	$(SRC)/ThermalBase.cpp \
+	$(SRC)/ThermalLocator.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/GlideRatio.cpp \
+	$(SRC)/AutoQNH.cpp \
+	$(SRC)/BasicComputer.cpp \
+	$(SRC)/GlideComputer.cpp \
+	$(SRC)/GlideComputerBlackboard.cpp \
+	$(SRC)/GlideComputerTask.cpp \
+	$(SRC)/GlideComputerInterface.cpp \
+	$(SRC)/GlideComputerAirData.cpp \
+	$(SRC)/GlideComputerStats.cpp \
+	$(SRC)/StageProfiler.cpp \
+	$(SRC)/CalculationProfiler.cpp \
+	$(SRC)/SettingsComputer.cpp \
+	$(SRC)/SettingsComputerBlackboard.cpp \
+	$(SRC)/Replay/IGCParser.cpp \
+	$(SRC)/Audio/VegaVoice.cpp \
+	$(SRC)/TeamCodeCalculation.cpp \
+	$(SRC)/Engine/Navigation/TraceHistory.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceParser.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(SRC)/Compatibility/string.c \
+	$(SRC)/Operation.cpp \
+	$(SRC)/xmlParser.cpp \
+	$(ENGINE_SRC_DIR)/Atmosphere/Pressure.cpp \
+	$(TEST_SRC_DIR)/FakeDialogs.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/FakeLanguage.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/FakeMessage.cpp \
+	$(TEST_SRC_DIR)/RunGlideComputer.cpp
+RUN_GLIDE_COMPUTER_OBJS = $(call SRC_TO_OBJ,$(RUN_GLIDE_COMPUTER_SOURCES))
+RUN_GLIDE_COMPUTER_LDADD = \
+	$(ENGINE_LIBS) \
+	$(JASPER_LIBS) \
+	$(IO_LIBS) \
+	$(ZZIP_LIBS) \
+	$(UTIL_LIBS) \
+	$(MATH_LIBS)
+$(RUN_GLIDE_COMPUTER_OBJS): CPPFLAGS += $(SCREEN_CPPFLAGS)
+$(TARGET_BIN_DIR)/RunGlideComputer$(TARGET_EXEEXT): $(RUN_GLIDE_COMPUTER_OBJS) $(RUN_GLIDE_COMPUTER_LDADD) | $(TARGET_BIN_DIR)/dirstamp
+	@$(NQ)echo "  LINK    $@"
+	$(Q)$(LINK) $(LDFLAGS) $(TARGET_ARCH) $^ $(LOADLIBES) $(LDLIBS) $(ZZIP_LDFLAGS) -o $@
+
 RUN_AIRSPACE_WARNING_DIALOG_SOURCES = \
 	$(SRC)/Poco/RWLock.cpp \
 	$(SRC)/xmlParser.cpp \
@@ -1903,6 +2194,7 @@ RUN_TASK_EDITOR_DIALOG_SOURCES = \
 	$(SRC)/Geo/UTM.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
 	$(SRC)/Waypoint/WaypointReaderFS.cpp \
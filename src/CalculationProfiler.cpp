@@ -0,0 +1,44 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CalculationProfiler.hpp"
+
+static const TCHAR *const stage_names[CALC_NUM_STAGES] = {
+  _T("tick"),
+  _T("gps"),
+  _T("basic"),
+  _T("terrain"),
+  _T("task"),
+  _T("vertical"),
+  _T("wind"),
+  _T("thermal_locator"),
+  _T("climb_stats"),
+  _T("team_traffic"),
+  _T("trace"),
+  _T("idle"),
+  _T("logging"),
+  _T("airspace_warning"),
+  _T("task_idle"),
+};
+
+StageProfiler calculation_profiler(stage_names, CALC_NUM_STAGES);
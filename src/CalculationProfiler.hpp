@@ -0,0 +1,64 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_CALCULATION_PROFILER_HPP
+#define XCSOAR_CALCULATION_PROFILER_HPP
+
+#include "StageProfiler.hpp"
+
+/**
+ * The stages of the calculation thread which are timed by
+ * #calculation_profiler.  Stages may be nested, e.g. CALC_WIND is a
+ * part of CALC_VERTICAL, which is a part of CALC_GPS.
+ */
+enum CalculationStage {
+  /** one complete CalculationThread::Tick() */
+  CALC_TICK,
+  /** GlideComputer::ProcessGPS() */
+  CALC_GPS,
+  CALC_BASIC,
+  CALC_TERRAIN,
+  CALC_TASK,
+  CALC_VERTICAL,
+  CALC_WIND,
+  CALC_THERMAL_LOCATOR,
+  CALC_CLIMB_STATS,
+  CALC_TEAM_TRAFFIC,
+  CALC_TRACE,
+  /** GlideComputer::ProcessIdle() */
+  CALC_IDLE,
+  CALC_LOGGING,
+  CALC_AIRSPACE_WARNING,
+  /** task and contest updates in GlideComputerTask::ProcessIdle() */
+  CALC_TASK_IDLE,
+  CALC_NUM_STAGES
+};
+
+/**
+ * The profiler of the calculation thread.  It is disabled by
+ * default, and may be enabled at runtime with the "Profiler" input
+ * event.
+ */
+extern StageProfiler calculation_profiler;
+
+#endif
@@ -28,6 +28,7 @@ Copyright_License {
 #include "DeviceBlackboard.hpp"
 #include "Components.hpp"
 #include "GlideSolvers/GlidePolar.hpp"
+#include "CalculationProfiler.hpp"
 
 /**
  * Constructor of the CalculationThread class
@@ -57,6 +58,8 @@ CalculationThread::SetScreenDistanceMeters(fixed new_value)
 void
 CalculationThread::Tick()
 {
+  ScopeStageTimer stage_timer(calculation_profiler, CALC_TICK);
+
   bool gps_updated;
 
   // update and transfer master info to glide computer
@@ -132,6 +132,13 @@ AllDevicesLinkTimeout()
     DeviceList[i].LinkTimeout();
 }
 
+void
+AllDevicesParseReceived()
+{
+  for (unsigned i = 0; i < NUMDEV; ++i)
+    DeviceList[i].ParseReceived();
+}
+
 bool
 AllDevicesIsBusy()
 {
@@ -55,6 +55,12 @@ void AllDevicesPutVoice(const TCHAR *sentence);
 
 void AllDevicesLinkTimeout();
 
+/**
+ * Parses the lines received by all devices.  Caller must lock the
+ * DeviceBlackboard.
+ */
+void AllDevicesParseReceived();
+
 /**
  * Is any device currently declaring a task?
  */
@@ -39,6 +39,7 @@ Copyright_License {
 #endif
 
 #include <assert.h>
+#include <string.h>
 
 DeviceDescriptor::DeviceDescriptor()
   :Com(NULL), pDevPipeTo(NULL),
@@ -46,7 +47,7 @@ DeviceDescriptor::DeviceDescriptor()
 #ifdef ANDROID
    internal_gps(NULL),
 #endif
-   ticker(false), busy(false)
+   ticker(false), busy(false), port_error(false)
 {
 }
 
@@ -66,6 +67,7 @@ DeviceDescriptor::Open(const DeviceConfig &config, Port *_port,
   assert(!ticker);
 
   device_blackboard.mutex.Lock();
+  received.clear();
   device_blackboard.SetRealState(index).Reset();
   device_blackboard.ScheduleMerge();
   device_blackboard.mutex.Unlock();
@@ -103,8 +105,14 @@ DeviceDescriptor::Close()
   internal_gps = NULL;
 #endif
 
-  delete device;
+  /* queued lines are parsed with the blackboard locked; detach the
+     device before deleting it */
+  device_blackboard.mutex.Lock();
+  Device *old_device = device;
   device = NULL;
+  device_blackboard.mutex.Unlock();
+
+  delete old_device;
 
   Port *OldCom = Com;
   Com = NULL;
@@ -114,8 +122,10 @@ DeviceDescriptor::Close()
   Driver = NULL;
   pDevPipeTo = NULL;
   ticker = false;
+  port_error = false;
 
   device_blackboard.mutex.Lock();
+  received.clear();
   device_blackboard.SetRealState(index).Reset();
   device_blackboard.ScheduleMerge();
   device_blackboard.mutex.Unlock();
@@ -302,7 +312,7 @@ DeviceDescriptor::Declare(const struct Declaration &declaration,
   _stprintf(text, _("Declaring to %s"), Driver->display_name);
   env.SetText(text);
 
-  Com->StopRxThread();
+  StopRxThread();
 
   bool result = device != NULL && device->Declare(declaration, env);
 
@@ -329,7 +339,7 @@ DeviceDescriptor::ReadFlightList(RecordedFlightList &flight_list,
   _stprintf(text, _("Reading flight list from %s"), Driver->display_name);
   env.SetText(text);
 
-  Com->StopRxThread();
+  StopRxThread();
   bool result = device->ReadFlightList(flight_list, env);
   Com->StartRxThread();
   return result;
@@ -347,7 +357,7 @@ DeviceDescriptor::DownloadFlight(const RecordedFlightInfo &flight,
   _stprintf(text, _("Downloading flight from %s"), Driver->display_name);
   env.SetText(text);
 
-  Com->StopRxThread();
+  StopRxThread();
   bool result = device->DownloadFlight(flight, path, env);
   Com->StartRxThread();
   return result;
@@ -378,9 +388,57 @@ DeviceDescriptor::LineReceived(const char *line)
     pDevPipeTo->Com->Write("\r\n");
   }
 
+  ReceivedLine *slot = received.write();
+  if (slot == NULL) {
+    /* the MergeThread is lagging behind; instead of dropping this
+       line, parse the queue and the line right here */
+    ScopeLock protect(device_blackboard.mutex);
+    ParseReceived();
+
+    NMEA_INFO &basic = device_blackboard.SetRealState(index);
+    basic.UpdateClock();
+    if (ParseNMEA(line, basic))
+      device_blackboard.ScheduleMerge();
+    return;
+  }
+
+  strncpy(slot->text, line, sizeof(slot->text) - 1);
+  slot->text[sizeof(slot->text) - 1] = 0;
+  received.append();
+
+  device_blackboard.ScheduleMerge();
+}
+
+void
+DeviceDescriptor::PortError()
+{
+  port_error = true;
+}
+
+void
+DeviceDescriptor::StopRxThread()
+{
+  Com->StopRxThread();
+
   ScopeLock protect(device_blackboard.mutex);
-  NMEA_INFO &basic = device_blackboard.SetRealState(index);
-  basic.UpdateClock();
-  if (ParseNMEA(line, basic))
+  if (ParseReceived())
     device_blackboard.ScheduleMerge();
 }
+
+bool
+DeviceDescriptor::ParseReceived()
+{
+  NMEA_INFO &basic = device_blackboard.SetRealState(index);
+
+  bool modified = false;
+  const ReceivedLine *line;
+  while ((line = received.read()) != NULL) {
+    basic.UpdateClock();
+    if (ParseNMEA(line->text, basic))
+      modified = true;
+
+    received.consume();
+  }
+
+  return modified;
+}
@@ -28,6 +28,7 @@ Copyright_License {
 #include "Device/Parser.hpp"
 #include "RadioFrequency.hpp"
 #include "NMEA/ExternalSettings.hpp"
+#include "Thread/LockFreeFifo.hpp"
 
 #include <assert.h>
 #include <tchar.h>
@@ -46,6 +47,20 @@ struct RecordedFlightInfo;
 class OperationEnvironment;
 
 class DeviceDescriptor : public Port::Handler {
+  /**
+   * A line received from the port, waiting to be parsed.
+   */
+  struct ReceivedLine {
+    char text[256];
+  };
+
+  /**
+   * Lines queued by the port thread in LineReceived(), to be parsed
+   * by ParseReceived().  This way, the port thread doesn't have to
+   * wait for the DeviceBlackboard mutex, unless the queue is full.
+   */
+  LockFreeFifo<ReceivedLine, 32> received;
+
 public:
   /** the index of this device in the global list */
   unsigned index;
@@ -88,6 +103,12 @@ public:
    */
   bool busy;
 
+  /**
+   * Set by the port's receiving thread when the port has failed.
+   * Cleared by Close().
+   */
+  volatile bool port_error;
+
 public:
   DeviceDescriptor();
   ~DeviceDescriptor();
@@ -147,6 +168,14 @@ public:
     return busy;
   }
 
+  /**
+   * Has the port stopped receiving because of an error?  The device
+   * needs to be reopened then.
+   */
+  bool HasPortError() const {
+    return port_error;
+  }
+
   void SetBusy(bool _busy) {
     assert(_busy != busy);
 
@@ -178,7 +207,24 @@ public:
 
   void OnSysTicker(const NMEA_INFO &basic, const DERIVED_INFO &calculated);
 
+  /**
+   * Parses all lines queued by LineReceived() into this device's
+   * NMEA_INFO.  Caller must lock the DeviceBlackboard.
+   *
+   * @return true if the NMEA_INFO was modified
+   */
+  bool ParseReceived();
+
   virtual void LineReceived(const char *line);
+  virtual void PortError();
+
+private:
+  /**
+   * Stops the port's receive thread and parses the lines it has
+   * queued.  After that, the MergeThread will not call into the
+   * driver, and the caller may talk to the device directly.
+   */
+  void StopRxThread();
 };
 
 #endif
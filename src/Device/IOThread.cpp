@@ -0,0 +1,271 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Device/IOThread.hpp"
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <assert.h>
+
+IOThread::IOThread()
+  :quit(false), running(false)
+{
+  if (pipe(wake_fds) < 0) {
+    wake_fds[0] = wake_fds[1] = -1;
+    return;
+  }
+
+  for (unsigned i = 0; i < 2; ++i) {
+    fcntl(wake_fds[i], F_SETFL, fcntl(wake_fds[i], F_GETFL) | O_NONBLOCK);
+    fcntl(wake_fds[i], F_SETFD, fcntl(wake_fds[i], F_GETFD) | FD_CLOEXEC);
+  }
+}
+
+IOThread::~IOThread()
+{
+  assert(!IsDefined());
+
+  if (wake_fds[0] >= 0) {
+    close(wake_fds[0]);
+    close(wake_fds[1]);
+  }
+}
+
+bool
+IOThread::Start()
+{
+  assert(!IsDefined());
+
+  if (wake_fds[0] < 0)
+    return false;
+
+  quit = false;
+  return Thread::Start();
+}
+
+void
+IOThread::Stop()
+{
+  assert(!IsInside());
+
+  if (!IsDefined())
+    return;
+
+  mutex.Lock();
+  quit = true;
+  mutex.Unlock();
+
+  Wakeup();
+  Join();
+}
+
+IOThread::FileVector::iterator
+IOThread::Find(int fd)
+{
+  for (FileVector::iterator i = files.begin(), end = files.end();
+       i != end; ++i)
+    if (i->fd == fd)
+      return i;
+
+  return files.end();
+}
+
+void
+IOThread::Add(int fd, unsigned mask, FileEventHandler &handler)
+{
+  assert(fd >= 0);
+
+  mutex.Lock();
+
+  FileVector::iterator i = Find(fd);
+  if (i != files.end()) {
+    i->mask = mask;
+    i->handler = &handler;
+  } else
+    files.push_back(File(fd, mask, handler));
+
+  mutex.Unlock();
+
+  Wakeup();
+}
+
+void
+IOThread::LockIdle()
+{
+  mutex.Lock();
+
+  /* wait until the handler which may be running right now has
+     returned */
+  if (!IsInside())
+    while (running)
+      cond.Wait(mutex);
+}
+
+void
+IOThread::Remove(int fd)
+{
+  LockIdle();
+
+  FileVector::iterator i = Find(fd);
+  if (i != files.end())
+    files.erase(i);
+
+  mutex.Unlock();
+
+  Wakeup();
+}
+
+void
+IOThread::RemoveAll(FileEventHandler &handler)
+{
+  LockIdle();
+
+  FileVector::iterator i = files.begin();
+  while (i != files.end()) {
+    if (i->handler == &handler)
+      i = files.erase(i);
+    else
+      ++i;
+  }
+
+  mutex.Unlock();
+
+  Wakeup();
+}
+
+void
+IOThread::Wakeup()
+{
+  static const char dummy = 0;
+  /* if the pipe is full, the thread is going to wake up anyway */
+  ssize_t nbytes = write(wake_fds[1], &dummy, sizeof(dummy));
+  (void)nbytes;
+}
+
+void
+IOThread::DrainWakeup()
+{
+  char buffer[256];
+  while (read(wake_fds[0], buffer, sizeof(buffer)) > 0) {}
+}
+
+void
+IOThread::Run()
+{
+  std::vector<struct pollfd> pfds;
+
+  mutex.Lock();
+
+  while (!quit) {
+    pfds.resize(files.size() + 1);
+    pfds[0].fd = wake_fds[0];
+    pfds[0].events = POLLIN;
+    for (unsigned i = 0; i < files.size(); ++i) {
+      pfds[i + 1].fd = files[i].fd;
+      pfds[i + 1].events = files[i].mask;
+    }
+
+    running = false;
+    cond.Broadcast();
+    mutex.Unlock();
+
+    int ret = poll(&pfds.front(), pfds.size(), -1);
+
+    mutex.Lock();
+    if (ret <= 0)
+      continue;
+
+    if (pfds[0].revents != 0)
+      DrainWakeup();
+
+    running = true;
+
+    for (unsigned i = 1; i < pfds.size() && !quit; ++i) {
+      const struct pollfd &pfd = pfds[i];
+      if (pfd.revents == 0)
+        continue;
+
+      /* the file may have been removed meanwhile */
+      FileVector::iterator f = Find(pfd.fd);
+      if (f == files.end())
+        continue;
+
+      FileEventHandler &handler = *f->handler;
+
+      mutex.Unlock();
+      const bool keep = handler.OnFileEvent(pfd.fd, pfd.revents);
+      mutex.Lock();
+
+      if (!keep) {
+        f = Find(pfd.fd);
+        if (f != files.end() && f->handler == &handler)
+          files.erase(f);
+      }
+    }
+  }
+
+  running = false;
+  cond.Broadcast();
+  mutex.Unlock();
+}
+
+static PosixMutex io_thread_mutex;
+static IOThread *io_thread;
+static unsigned io_thread_refs;
+
+IOThread *
+AcquireIOThread()
+{
+  io_thread_mutex.Lock();
+
+  if (io_thread_refs == 0) {
+    io_thread = new IOThread();
+    if (!io_thread->Start()) {
+      delete io_thread;
+      io_thread = NULL;
+      io_thread_mutex.Unlock();
+      return NULL;
+    }
+  }
+
+  ++io_thread_refs;
+  IOThread *result = io_thread;
+  io_thread_mutex.Unlock();
+  return result;
+}
+
+void
+ReleaseIOThread()
+{
+  io_thread_mutex.Lock();
+
+  assert(io_thread_refs > 0);
+
+  if (--io_thread_refs == 0) {
+    io_thread->Stop();
+    delete io_thread;
+    io_thread = NULL;
+  }
+
+  io_thread_mutex.Unlock();
+}
@@ -0,0 +1,166 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_DEVICE_IO_THREAD_HPP
+#define XCSOAR_DEVICE_IO_THREAD_HPP
+
+#include "Thread/Thread.hpp"
+#include "Thread/PosixMutex.hpp"
+#include "Thread/Cond.hpp"
+
+#include <vector>
+
+#include <sys/poll.h>
+
+/**
+ * Interface with callbacks for the #IOThread class.
+ */
+class FileEventHandler {
+public:
+  /**
+   * Called by the #IOThread when a file descriptor becomes ready.
+   *
+   * @param fd the file descriptor
+   * @param mask the events which occurred (IOThread::READ etc.)
+   * @return false to unregister the file descriptor
+   */
+  virtual bool OnFileEvent(int fd, unsigned mask) = 0;
+};
+
+/**
+ * A thread which waits for events on a set of file descriptors with
+ * poll(), and dispatches them to their #FileEventHandler.  A
+ * self-pipe wakes it up when the set changes or when it shall exit.
+ *
+ * This replaces one polling receive thread per port.
+ */
+class IOThread : protected Thread {
+public:
+  enum {
+    READ = POLLIN,
+    WRITE = POLLOUT,
+    ERROR = POLLERR,
+    HANGUP = POLLHUP,
+  };
+
+private:
+  struct File {
+    int fd;
+    unsigned mask;
+    FileEventHandler *handler;
+
+    File(int _fd, unsigned _mask, FileEventHandler &_handler)
+      :fd(_fd), mask(_mask), handler(&_handler) {}
+  };
+
+  typedef std::vector<File> FileVector;
+
+  /**
+   * Protects all attributes below.
+   */
+  PosixMutex mutex;
+
+  /**
+   * Signalled when the thread has finished dispatching events.
+   */
+  Cond cond;
+
+  FileVector files;
+
+  /**
+   * The self-pipe: writing a byte to wake_fds[1] interrupts poll().
+   */
+  int wake_fds[2];
+
+  bool quit;
+
+  /**
+   * Is the thread currently calling event handlers?
+   */
+  bool running;
+
+public:
+  IOThread();
+  virtual ~IOThread();
+
+  bool Start();
+
+  /**
+   * Stops the thread and waits for it to exit.
+   */
+  void Stop();
+
+  /**
+   * Registers a file descriptor, or changes the event mask and the
+   * handler of one that is already registered.  May be called from
+   * any thread, including from within a handler.
+   */
+  void Add(int fd, unsigned mask, FileEventHandler &handler);
+
+  /**
+   * Unregisters a file descriptor.  When called from another thread,
+   * this waits until the handler is not running anymore; after
+   * returning, it will not be invoked again for this file descriptor.
+   */
+  void Remove(int fd);
+
+  /**
+   * Unregisters all file descriptors of the specified handler, with
+   * the same guarantees as Remove().
+   */
+  void RemoveAll(FileEventHandler &handler);
+
+protected:
+  virtual void Run();
+
+private:
+  /**
+   * Locks the mutex and waits until no handler is running, unless
+   * called from within a handler.
+   */
+  void LockIdle();
+
+  void Wakeup();
+  void DrainWakeup();
+
+  FileVector::iterator Find(int fd);
+};
+
+/**
+ * Returns the global #IOThread, starting it if this is the first
+ * reference.  Each successful call must be paired with
+ * ReleaseIOThread().
+ *
+ * @return the thread, or NULL if it could not be started
+ */
+IOThread *
+AcquireIOThread();
+
+/**
+ * Releases a reference obtained with AcquireIOThread().  The thread
+ * is stopped when the last reference is released.
+ */
+void
+ReleaseIOThread();
+
+#endif
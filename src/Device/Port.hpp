@@ -37,6 +37,13 @@ public:
   class Handler {
   public:
     virtual void LineReceived(const char *line) = 0;
+
+    /**
+     * Called by the receiving thread when the port has failed, e.g.
+     * because the device was unplugged.  No more lines will be
+     * received until the port is opened again.
+     */
+    virtual void PortError() {}
   };
 
 protected:
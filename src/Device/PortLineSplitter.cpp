@@ -0,0 +1,78 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Device/PortLineSplitter.hpp"
+
+#include <algorithm>
+
+#include <string.h>
+#include <assert.h>
+
+void
+PortLineSplitter::Append(const char *src, const char *end)
+{
+  if (overflow)
+    return;
+
+  Buffer::Range range = buffer.write();
+
+  /* one byte is reserved for the null terminator */
+  if ((unsigned)(end - src) >= range.second &&
+      (unsigned)(end - src - std::count(src, end, '\r')) >= range.second) {
+    buffer.clear();
+    overflow = true;
+    return;
+  }
+
+  char *p = std::remove_copy(src, end, range.first, '\r');
+  buffer.append(p - range.first);
+}
+
+void
+PortLineSplitter::DataReceived(const char *data, size_t length)
+{
+  const char *end = data + length;
+
+  while (data < end) {
+    const char *eol = (const char *)memchr(data, '\n', end - data);
+    if (eol == NULL) {
+      Append(data, end);
+      break;
+    }
+
+    Append(data, eol);
+
+    if (!overflow) {
+      Buffer::Range range = buffer.write();
+      assert(range.second > 0);
+      range.first[0] = '\0';
+      buffer.append(1);
+
+      range = buffer.read();
+      handler.LineReceived(range.first);
+    }
+
+    Clear();
+    data = eol + 1;
+  }
+}
@@ -0,0 +1,70 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_DEVICE_PORT_LINE_SPLITTER_HPP
+#define XCSOAR_DEVICE_PORT_LINE_SPLITTER_HPP
+
+#include "FifoBuffer.hpp"
+#include "Device/Port.hpp"
+
+/**
+ * Splits the raw data received by a #Port into lines, and passes
+ * them to a #Port::Handler.  Carriage returns are stripped.  A line
+ * which does not fit into the buffer is discarded.
+ */
+class PortLineSplitter {
+  typedef FifoBuffer<char, 256u> Buffer;
+
+  Port::Handler &handler;
+
+  Buffer buffer;
+
+  /**
+   * Is the current line too long?  It will be discarded up to the
+   * next newline.
+   */
+  bool overflow;
+
+public:
+  PortLineSplitter(Port::Handler &_handler)
+    :handler(_handler), overflow(false) {}
+
+  /**
+   * Discards the partial line.
+   */
+  void Clear() {
+    buffer.clear();
+    overflow = false;
+  }
+
+  /**
+   * Feeds a chunk of received data.  Calls Port::Handler::LineReceived()
+   * for each complete line.
+   */
+  void DataReceived(const char *data, size_t length);
+
+private:
+  void Append(const char *src, const char *end);
+};
+
+#endif
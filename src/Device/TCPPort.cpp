@@ -40,7 +40,11 @@ Copyright_License {
 
 TCPPort::TCPPort(unsigned _port, Handler &_handler)
   :Port(_handler), port(_port), rx_timeout(0),
-   listener_fd(-1), connection_fd(-1)
+   listener_fd(-1), connection_fd(-1),
+#ifdef HAVE_POSIX
+   io_thread(NULL),
+#endif
+   splitter(_handler)
 {
 }
 
@@ -87,6 +91,14 @@ TCPPort::Open()
     return false;
   }
 
+#ifdef HAVE_POSIX
+  io_thread = AcquireIOThread();
+  if (io_thread == NULL) {
+    close(listener_fd);
+    listener_fd = -1;
+    return false;
+  }
+#endif
   return true;
 }
 
@@ -95,6 +107,45 @@ TCPPort::Flush(void)
 {
 }
 
+#ifdef HAVE_POSIX
+
+bool
+TCPPort::OnFileEvent(int fd, unsigned mask)
+{
+  if (fd == listener_fd) {
+    /* accept new connection */
+
+    connection_fd = accept(listener_fd, NULL, NULL);
+    if (connection_fd < 0)
+      return true;
+
+    /* only one client at a time; the listener is registered again
+       when the connection is closed */
+    io_thread->Add(connection_fd, IOThread::READ, *this);
+    return false;
+  }
+
+  /* read from existing client connection */
+
+  assert(fd == connection_fd);
+
+  char buffer[1024];
+  ssize_t nbytes = recv(connection_fd, buffer, sizeof(buffer), 0);
+  if (nbytes <= 0) {
+    close(connection_fd);
+    connection_fd = -1;
+    splitter.Clear();
+
+    io_thread->Add(listener_fd, IOThread::READ, *this);
+    return false;
+  }
+
+  splitter.DataReceived(buffer, nbytes);
+  return true;
+}
+
+#else
+
 void
 TCPPort::Run()
 {
@@ -144,8 +195,7 @@ TCPPort::Run()
           continue;
         }
 
-        for (ssize_t i = 0; i < nbytes; ++i)
-          ProcessChar(buffer[i]);
+        splitter.DataReceived(buffer, nbytes);
       } else if (ret < 0) {
         close(connection_fd);
         connection_fd = -1;
@@ -154,6 +204,8 @@ TCPPort::Run()
   }
 }
 
+#endif
+
 bool
 TCPPort::Close()
 {
@@ -164,6 +216,11 @@ TCPPort::Close()
 
   StopRxThread();
 
+#ifdef HAVE_POSIX
+  ReleaseIOThread();
+  io_thread = NULL;
+#endif
+
   if (connection_fd >= 0) {
     close(connection_fd);
     connection_fd = -1;
@@ -187,13 +244,18 @@ TCPPort::Write(const void *data, size_t length)
 bool
 TCPPort::StopRxThread()
 {
-  // Make sure the thread isn't terminating itself
-  assert(!Thread::IsInside());
-
   // Make sure the port is still open
   if (listener_fd < 0)
     return false;
 
+#ifdef HAVE_POSIX
+  io_thread->RemoveAll(*this);
+
+  return true;
+#else
+  // Make sure the thread isn't terminating itself
+  assert(!Thread::IsInside());
+
   // If the thread is not running, cancel the rest of the function
   if (!Thread::IsDefined())
     return true;
@@ -203,20 +265,28 @@ TCPPort::StopRxThread()
   Thread::Join();
 
   return true;
+#endif
 }
 
 bool
 TCPPort::StartRxThread(void)
 {
-  // Make sure the thread isn't starting itself
-  assert(!Thread::IsInside());
-
   // Make sure the port was opened correctly
   if (listener_fd < 0)
     return false;
 
+#ifdef HAVE_POSIX
+  if (connection_fd >= 0)
+    io_thread->Add(connection_fd, IOThread::READ, *this);
+  else
+    io_thread->Add(listener_fd, IOThread::READ, *this);
+#else
+  // Make sure the thread isn't starting itself
+  assert(!Thread::IsInside());
+
   // Start the receive thread
   StoppableThread::Start();
+#endif
   return true;
 }
 
@@ -260,26 +330,3 @@ TCPPort::Read(void *buffer, size_t length)
 
   return read(ufd, buffer, length);
 }
-
-void
-TCPPort::ProcessChar(char c)
-{
-  Buffer::Range range = buffer.write();
-  if (range.second == 0) {
-    // overflow, so reset buffer
-    buffer.clear();
-    return;
-  }
-
-  if (c == '\n') {
-    range.first[0] = _T('\0');
-    buffer.append(1);
-
-    range = buffer.read();
-    handler.LineReceived(range.first);
-    buffer.clear();
-  } else if (c != '\r') {
-    range.first[0] = c;
-    buffer.append(1);
-  }
-}
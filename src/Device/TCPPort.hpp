@@ -24,24 +24,38 @@ Copyright_License {
 #ifndef XCSOAR_DEVICE_TCP_PORT_HPP
 #define XCSOAR_DEVICE_TCP_PORT_HPP
 
-#include "FifoBuffer.hpp"
-#include "Thread/StoppableThread.hpp"
 #include "Device/Port.hpp"
+#include "Device/PortLineSplitter.hpp"
+
+#ifdef HAVE_POSIX
+#include "Device/IOThread.hpp"
+#else
+#include "Thread/StoppableThread.hpp"
+#endif
 
 /**
- * A serial port class for POSIX (/dev/ttyS*, /dev/ttyUSB*).
+ * A port class which accepts one TCP connection at a time.  On POSIX,
+ * input is received by the shared #IOThread.
  */
-class TCPPort : public Port, protected StoppableThread
+class TCPPort : public Port,
+#ifdef HAVE_POSIX
+                private FileEventHandler
+#else
+                protected StoppableThread
+#endif
 {
-  typedef FifoBuffer<char, 256u> Buffer;
-
   unsigned port;
 
   unsigned rx_timeout;
 
   int listener_fd, connection_fd;
 
-  Buffer buffer;
+#ifdef HAVE_POSIX
+  /** The thread receiving from this port, obtained in Open() */
+  IOThread *io_thread;
+#endif
+
+  PortLineSplitter splitter;
 
 public:
   /**
@@ -77,15 +91,19 @@ public:
   virtual unsigned SetBaudrate(unsigned BaudRate);
   virtual bool StopRxThread();
   virtual bool StartRxThread();
-  void ProcessChar(char c);
 
   virtual int Read(void *buffer, size_t length);
 
+#ifdef HAVE_POSIX
+private:
+  virtual bool OnFileEvent(int fd, unsigned mask);
+#else
 protected:
   /**
    * Entry point for the receive thread
    */
   virtual void Run();
+#endif
 };
 
 #endif
@@ -23,7 +23,6 @@ Copyright_License {
 
 #include "Device/TTYPort.hpp"
 #include "Asset.hpp"
-#include "OS/Sleep.h"
 
 #include <time.h>
 #include <fcntl.h>
@@ -37,7 +36,7 @@ Copyright_License {
 
 TTYPort::TTYPort(const TCHAR *path, unsigned _baud_rate, Handler &_handler)
   :Port(_handler), rx_timeout(0), baud_rate(_baud_rate),
-   fd(-1)
+   fd(-1), io_thread(NULL), splitter(_handler)
 {
   assert(path != NULL);
 
@@ -59,6 +58,13 @@ TTYPort::Open()
 
   SetBaudrate(baud_rate);
 
+  io_thread = AcquireIOThread();
+  if (io_thread == NULL) {
+    close(fd);
+    fd = -1;
+    return false;
+  }
+
   return true;
 }
 
@@ -68,19 +74,25 @@ TTYPort::Flush(void)
   tcflush(fd, TCIOFLUSH);
 }
 
-void
-TTYPort::Run()
+bool
+TTYPort::OnFileEvent(int _fd, unsigned mask)
 {
-  char buffer[1024];
+  assert(_fd == fd);
 
-  // XXX use poll()
-  while (!WaitForStopped(50)) {
-    ssize_t nbytes = read(fd, buffer, sizeof(buffer));
-    for (ssize_t i = 0; i < nbytes; ++i)
-      ProcessChar(buffer[i]);
+  char buffer[1024];
+  ssize_t nbytes = read(fd, buffer, sizeof(buffer));
+  if (nbytes > 0) {
+    splitter.DataReceived(buffer, nbytes);
+    return true;
   }
 
-  Flush();
+  if ((mask & (IOThread::ERROR | IOThread::HANGUP)) == 0)
+    return true;
+
+  /* stop receiving if the device has gone away, or poll() would
+     return immediately forever; the owner reopens the port */
+  handler.PortError();
+  return false;
 }
 
 bool
@@ -90,6 +102,8 @@ TTYPort::Close()
     return true;
 
   StopRxThread();
+  ReleaseIOThread();
+  io_thread = NULL;
 
   close(fd);
   fd = -1;
@@ -109,20 +123,14 @@ TTYPort::Write(const void *data, size_t length)
 bool
 TTYPort::StopRxThread()
 {
-  // Make sure the thread isn't terminating itself
-  assert(!Thread::IsInside());
-
   // Make sure the port is still open
   if (fd < 0)
     return false;
 
-  // If the thread is not running, cancel the rest of the function
-  if (!Thread::IsDefined())
-    return true;
-
-  BeginStop();
+  io_thread->Remove(fd);
 
-  Thread::Join();
+  Flush();
+  splitter.Clear();
 
   return true;
 }
@@ -130,15 +138,11 @@ TTYPort::StopRxThread()
 bool
 TTYPort::StartRxThread(void)
 {
-  // Make sure the thread isn't starting itself
-  assert(!Thread::IsInside());
-
   // Make sure the port was opened correctly
   if (fd < 0)
     return false;
 
-  // Start the receive thread
-  StoppableThread::Start();
+  io_thread->Add(fd, IOThread::READ, *this);
   return true;
 }
 
@@ -281,26 +285,3 @@ TTYPort::Read(void *Buffer, size_t Size)
 
   return read(fd, Buffer, Size);
 }
-
-void
-TTYPort::ProcessChar(char c)
-{
-  Buffer::Range range = buffer.write();
-  if (range.second == 0) {
-    // overflow, so reset buffer
-    buffer.clear();
-    return;
-  }
-
-  if (c == '\n') {
-    range.first[0] = _T('\0');
-    buffer.append(1);
-
-    range = buffer.read();
-    handler.LineReceived(range.first);
-    buffer.clear();
-  } else if (c != '\r') {
-    range.first[0] = c;
-    buffer.append(1);
-  }
-}
@@ -24,17 +24,18 @@ Copyright_License {
 #ifndef XCSOAR_DEVICE_TTY_PORT_HPP
 #define XCSOAR_DEVICE_TTY_PORT_HPP
 
-#include "FifoBuffer.hpp"
-#include "Thread/StoppableThread.hpp"
 #include "Device/Port.hpp"
+#include "Device/PortLineSplitter.hpp"
+#include "Device/IOThread.hpp"
+
+#include <tchar.h>
 
 /**
- * A serial port class for POSIX (/dev/ttyS*, /dev/ttyUSB*).
+ * A serial port class for POSIX (/dev/ttyS*, /dev/ttyUSB*).  Input
+ * is received by the shared #IOThread.
  */
-class TTYPort : public Port, protected StoppableThread
+class TTYPort : public Port, private FileEventHandler
 {
-  typedef FifoBuffer<char, 256u> Buffer;
-
   /** Name of the serial port */
   TCHAR sPortName[64];
 
@@ -44,7 +45,10 @@ class TTYPort : public Port, protected StoppableThread
 
   int fd;
 
-  Buffer buffer;
+  /** The thread receiving from this port, obtained in Open() */
+  IOThread *io_thread;
+
+  PortLineSplitter splitter;
 
 public:
   /**
@@ -81,15 +85,11 @@ public:
   virtual unsigned SetBaudrate(unsigned BaudRate);
   virtual bool StopRxThread();
   virtual bool StartRxThread();
-  void ProcessChar(char c);
 
   virtual int Read(void *Buffer, size_t Size);
 
-protected:
-  /**
-   * Entry point for the receive thread
-   */
-  virtual void Run();
+private:
+  virtual bool OnFileEvent(int fd, unsigned mask);
 };
 
 #endif
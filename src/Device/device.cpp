@@ -477,3 +477,18 @@ devRestart()
 
   devStartup();
 }
+
+void
+devRestartOnPortError()
+{
+  bool failed = false;
+  for (unsigned i = 0; i < NUMDEV; ++i) {
+    if (DeviceList[i].HasPortError()) {
+      LogStartUp(_T("Port of device %u has failed"), i);
+      failed = true;
+    }
+  }
+
+  if (failed)
+    devRestart();
+}
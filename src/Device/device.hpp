@@ -46,4 +46,10 @@ void devStartup();
 void devShutdown();
 void devRestart(void);
 
+/**
+ * Restarts all devices if the port of one of them has failed, so it
+ * is reopened once it is available again.
+ */
+void devRestartOnPortError();
+
 #endif
@@ -270,6 +270,8 @@ DeviceBlackboard::ScheduleMerge()
 void
 DeviceBlackboard::Merge()
 {
+  AllDevicesParseReceived();
+
   real_data.Reset();
   for (unsigned i = 0; i < NUMDEV; ++i) {
     if (!per_device_data[i].Connected)
@@ -126,8 +126,9 @@ public:
   void ScheduleMerge();
 
   /**
-   * Copy real_data or simulator_data or replay_data to gps_info.
-   * Caller must lock the blackboard.
+   * Parse the lines queued by the devices, and copy real_data or
+   * simulator_data or replay_data to gps_info.  Caller must lock the
+   * blackboard.
    */
   void Merge();
 };
@@ -248,6 +248,7 @@ Airspaces::insert(AbstractAirspace* asp)
   }
 
   tmp_as.push_back(asp);
+  ++serial;
 }
 
 void
@@ -273,6 +274,7 @@ Airspaces::clear()
 
   // then delete the tree
   airspace_tree.clear();
+  ++serial;
 }
 
 unsigned
@@ -335,7 +337,8 @@ Airspaces::Airspaces(const Airspaces& master,
   m_QNH(master.m_QNH),
   m_day(master.m_day),
   m_owner(owner),
-  task_projection(master.task_projection)
+  task_projection(master.task_projection),
+  serial(0)
 {
 }
 
@@ -405,6 +408,7 @@ Airspaces::synchronise_in_range(const Airspaces& master,
     v->clear_clearance();
     v = contents_self.erase(v);
     changed = true;
+    ++serial;
   }
   if (changed)
     optimise();
@@ -75,6 +75,9 @@ class Airspaces:
 
   std::deque< AbstractAirspace* > tmp_as;
 
+  /** Incremented whenever airspaces are added or deleted */
+  unsigned serial;
+
 public:
   /** 
    * Constructor.
@@ -85,7 +88,7 @@ public:
    *
    * @return empty Airspaces class.
    */
-  Airspaces():m_QNH(0), m_owner(true) {}
+  Airspaces():m_QNH(0), m_owner(true), serial(0) {}
 
   /**
    * Make a copy of the airspaces metadata
@@ -253,6 +256,15 @@ public:
   gcc_pure
   AirspaceTree::const_iterator end() const;
 
+  /**
+   * Returns a number which changes whenever airspaces are added or
+   * deleted.  Renderers may use it to decide whether cached data
+   * referring to airspace objects is still valid.
+   */
+  unsigned GetSerial() const {
+    return serial;
+  }
+
   const TaskProjection& get_task_projection() const {
     return task_projection;
   }
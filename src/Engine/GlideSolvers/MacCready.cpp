@@ -33,7 +33,8 @@
 #define fixed_1mil fixed_int_constant(1000000)
 
 #ifdef INSTRUMENT_TASK
-// global, used for test harness
+// global, used for test harness; incremented atomically, because
+// the batch tools solve on several threads
 long count_mc = 0;
 #endif
 
@@ -93,7 +94,7 @@ GlideResult
 MacCready::solve(const GlidePolar &glide_polar, const GlideState &task)
 {
 #ifdef INSTRUMENT_TASK
-  count_mc++;
+  __sync_fetch_and_add(&count_mc, 1);
 #endif
   MacCready mac(glide_polar, glide_polar.GetCruiseEfficiency());
   return mac.solve(task);
@@ -104,7 +105,7 @@ MacCready::solve_sink(const GlidePolar &glide_polar, const GlideState &task,
                       const fixed S)
 {
 #ifdef INSTRUMENT_TASK
-  count_mc++;
+  __sync_fetch_and_add(&count_mc, 1);
 #endif
   MacCready mac(glide_polar, glide_polar.GetCruiseEfficiency());
   return mac.solve_sink(task, S);
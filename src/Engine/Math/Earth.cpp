@@ -24,8 +24,11 @@ Copyright_License {
 #include "Math/Earth.hpp"
 #include <assert.h>
 
-// global, used for test harness
+#ifdef INSTRUMENT_TASK
+// global, used for test harness; incremented atomically, because
+// the batch tools solve on several threads
 unsigned count_distbearing = 0;
+#endif
 
 #define fixed_double_earth_r fixed(REARTH * 2)
 
@@ -90,7 +93,7 @@ IntermediatePoint(const GeoPoint loc1, const GeoPoint loc2, fixed dthis, fixed d
   loc3.normalize(); // ensure longitude is within -180:180
 
 #ifdef INSTRUMENT_TASK
-  count_distbearing++;
+  __sync_fetch_and_add(&count_distbearing, 1);
 #endif
 
   return loc3;
@@ -153,7 +156,7 @@ DistanceBearingS(const GeoPoint loc1, const GeoPoint loc2,
   }
 
 #ifdef INSTRUMENT_TASK
-  count_distbearing++;
+  __sync_fetch_and_add(&count_distbearing, 1);
 #endif
 }
 
@@ -199,7 +202,7 @@ CrossTrackError(const GeoPoint loc1, const GeoPoint loc2,
   }
 
 #ifdef INSTRUMENT_TASK
-  count_distbearing++;
+  __sync_fetch_and_add(&count_distbearing, 1);
 #endif
 
   // units
@@ -236,7 +239,7 @@ ProjectedDistance(const GeoPoint loc1, const GeoPoint loc2, const GeoPoint loc3)
   const fixed ATD(earth_asin(sqrt(sindist_AD * sindist_AD - sinXTD * sinXTD) / cosXTD));
 
 #ifdef INSTRUMENT_TASK
-  count_distbearing++;
+  __sync_fetch_and_add(&count_distbearing, 1);
 #endif
 
   return ATD * fixed_earth_r;
@@ -259,7 +262,7 @@ DoubleDistance(const GeoPoint loc1, const GeoPoint loc2, const GeoPoint loc3)
   const fixed a23 = sqr(s32) + cloc2Latitude * cloc3Latitude * sqr(sl32);
 
 #ifdef INSTRUMENT_TASK
-  count_distbearing++;
+  __sync_fetch_and_add(&count_distbearing, 1);
 #endif
 
   return fixed_double_earth_r * 
@@ -311,7 +314,7 @@ FindLatitudeLongitude(const GeoPoint loc, const Angle Bearing,
   loc_out.normalize(); // ensure longitude is within -180:180
 
 #ifdef INSTRUMENT_TASK
-  count_distbearing++;
+  __sync_fetch_and_add(&count_distbearing, 1);
 #endif
 
   return loc_out;
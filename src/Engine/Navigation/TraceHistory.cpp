@@ -24,11 +24,39 @@ Copyright_License {
 #include "NMEA/MoreData.hpp"
 #include "NMEA/Derived.hpp"
 
+TraceHistory &
+TraceHistory::operator=(const TraceHistory &other)
+{
+  if (generation != other.generation) {
+    BruttoVario = other.BruttoVario;
+    NettoVario = other.NettoVario;
+    CirclingAverage = other.CirclingAverage;
+    generation = other.generation;
+  }
+
+  return *this;
+}
+
 void
 TraceHistory::append(const MoreData &basic)
 {
   BruttoVario.push(basic.BruttoVario);
   NettoVario.push(basic.NettoVario);
+  generation.Modified();
+}
+
+void
+TraceHistory::append_circling_average(fixed value)
+{
+  CirclingAverage.push(value);
+  generation.Modified();
+}
+
+void
+TraceHistory::clear_circling_average()
+{
+  CirclingAverage.clear();
+  generation.Modified();
 }
 
 void
@@ -37,4 +65,5 @@ TraceHistory::clear()
   BruttoVario.clear();
   NettoVario.clear();
   CirclingAverage.clear();
+  generation.Modified();
 }
@@ -22,20 +22,35 @@ Copyright_License {
 */
 #ifndef TRACEHISTORY_HPP
 #define TRACEHISTORY_HPP
-#include "Util/OverwritingRingBuffer.hpp"
-#include "Math/fixed.hpp"
+#include "Math/WindowStatistics.hpp"
+#include "Util/Generation.hpp"
 
-class TraceVariableHistory: public OverwritingRingBuffer<fixed, 30> {};
+class TraceVariableHistory: public WindowStatistics<30> {};
 
 struct MoreData;
 
+/**
+ * The buffers are public for reading only; all modifications must go
+ * through the methods, which update the generation.
+ */
 class TraceHistory {
+  /** Changes whenever one of the buffers is modified */
+  Generation generation;
+
 public:
   TraceVariableHistory BruttoVario;
   TraceVariableHistory NettoVario;
   TraceVariableHistory CirclingAverage;
 
+  /**
+   * Copies the buffers only if the other object has been modified
+   * since this one was last assigned from it.
+   */
+  TraceHistory &operator=(const TraceHistory &other);
+
   void append(const MoreData &basic);
+  void append_circling_average(fixed value);
+  void clear_circling_average();
   void clear();
 };
 
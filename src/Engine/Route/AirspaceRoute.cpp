@@ -338,10 +338,10 @@ AirspaceRoute::on_solve(const AGeoPoint& origin,
                         const AGeoPoint& destination)
 {
   if (m_airspaces.empty()) {
-    task_projection.reset(origin);
-    task_projection.update_fast();
+    anchor_projection(origin);
   } else {
     task_projection = m_airspaces.get_task_projection();
+    projection_valid = true;
   }
 }
 
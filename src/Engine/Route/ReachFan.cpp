@@ -43,8 +43,10 @@ struct ReachFanParms {
   ReachFanParms(const RoutePolars& _rpolars,
                 const TaskProjection& _task_proj,
                 const short _terrain_base,
-                const RasterMap* _terrain=NULL):
+                const RasterMap* _terrain=NULL,
+                ParallelRunner *_runner=NULL):
     rpolars(_rpolars), task_proj(_task_proj), terrain(_terrain), 
+    runner(_runner),
     terrain_base(_terrain_base),
     terrain_counter(0),
     fan_counter(0),
@@ -54,6 +56,7 @@ struct ReachFanParms {
   const RoutePolars &rpolars;
   const TaskProjection& task_proj;
   const RasterMap* terrain;
+  ParallelRunner *runner;
   int terrain_base;
   unsigned terrain_counter;
   unsigned fan_counter;
@@ -66,6 +69,27 @@ struct ReachFanParms {
   }
 };
 
+/**
+ * Traces a range of rays from one origin into an array.  The rays
+ * only read the terrain, so they may be traced concurrently.
+ */
+class ReachInterceptJob : public ParallelRunner::Job {
+  const ReachFanParms &parms;
+  const AGeoPoint &origin;
+  const int index_low;
+  FlatGeoPoint *intercepts;
+
+public:
+  ReachInterceptJob(const ReachFanParms &_parms, const AGeoPoint &_origin,
+                    const int _index_low, FlatGeoPoint *_intercepts)
+    :parms(_parms), origin(_origin), index_low(_index_low),
+     intercepts(_intercepts) {}
+
+  virtual void Run(unsigned i) {
+    intercepts[i] = parms.reach_intercept(index_low + i, origin);
+  }
+};
+
 static bool too_close(const FlatGeoPoint& p1, const FlatGeoPoint& p2)
 {
   const FlatGeoPoint k = p1-p2;
@@ -211,20 +235,41 @@ FlatTriangleFanTree::fill_reach(const AFlatGeoPoint &origin,
   const AGeoPoint ao (parms.task_proj.unproject(origin), origin.altitude);
   height = origin.altitude;
 
-  // fill vector
+  // child fans are rejected early if the middle ray is blocked; keep
+  // that intercept so the ray isn't traced a second time below
+  const int index_mid = (index_high+index_low)/2;
+  FlatGeoPoint x_mid;
   if (depth) {
-    const int index_mid = (index_high+index_low)/2;
-    const FlatGeoPoint x_mid = parms.reach_intercept(index_mid, ao);
+    x_mid = parms.reach_intercept(index_mid, ao);
     if (too_close(x_mid, origin))
       return;
   }
 
+  // fill vector
   assert(vs.empty());
   vs.reserve(index_high - index_low + 1);
   add_point(origin);
+
+  if (!depth && parms.runner != NULL) {
+    // the rays of the root fan are independent, trace them all at
+    // once; the tree is still built on this thread
+    const unsigned n = index_high - index_low;
+    FlatGeoPoint intercepts[ROUTEPOLAR_POINTS + 1];
+    assert(n <= ROUTEPOLAR_POINTS + 1);
+
+    ReachInterceptJob job(parms, ao, index_low, intercepts);
+    parms.runner->ForEach(job, n);
+
+    for (unsigned i = 0; i < n; ++i)
+      add_point(intercepts[i]);
+    return;
+  }
+
   for (int index= index_low; index< index_high; ++index) {
-    const FlatGeoPoint x = parms.reach_intercept(index, ao);
-    add_point(x);
+    if (depth && index == index_mid)
+      add_point(x_mid);
+    else
+      add_point(parms.reach_intercept(index, ao));
   }
 }
 
@@ -344,6 +389,35 @@ FlatTriangleFanTree::check_gap(const AFlatGeoPoint& n,
 void ReachFan::reset() {
   root.clear();
   terrain_base = 0;
+  solved = false;
+}
+
+bool
+ReachFan::update(const AGeoPoint origin,
+                 const RoutePolars &rpolars,
+                 const RasterMap* terrain,
+                 const bool do_solve,
+                 bool &changed)
+{
+  const unsigned serial = terrain ? terrain->GetSerial() : 0;
+
+  if (solved && origin == origin_solved && origin.altitude == h_solved &&
+      do_solve == do_solve_solved && terrain == terrain_solved &&
+      serial == terrain_serial) {
+    changed = false;
+    return result_solved;
+  }
+
+  result_solved = solve(origin, rpolars, terrain, do_solve);
+  solved = true;
+  origin_solved = origin;
+  h_solved = origin.altitude;
+  do_solve_solved = do_solve;
+  terrain_solved = terrain;
+  terrain_serial = serial;
+
+  changed = true;
+  return result_solved;
 }
 
 bool ReachFan::solve(const AGeoPoint origin,
@@ -361,7 +435,7 @@ bool ReachFan::solve(const AGeoPoint origin,
     : RasterBuffer::TERRAIN_INVALID;
   const short h2 = RasterBuffer::is_special(h) ? 0 : h;
 
-  ReachFanParms parms(rpolars, task_proj, terrain_base, terrain);
+  ReachFanParms parms(rpolars, task_proj, terrain_base, terrain, runner);
   const AFlatGeoPoint ao(task_proj.project(origin), origin.altitude);
 
   if (!RasterBuffer::is_invalid(h) &&
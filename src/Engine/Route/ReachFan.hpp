@@ -146,23 +146,92 @@ public:
   virtual void end_fan() = 0;
 };
 
+/**
+ * Runs a number of independent jobs, possibly on several threads.
+ * The task engine has no thread dependencies of its own; the
+ * application may supply an implementation to ReachFan.
+ */
+class ParallelRunner {
+public:
+  class Job {
+  public:
+    virtual void Run(unsigned index) = 0;
+  };
+
+  /**
+   * Calls Job::Run() once for each index below n, in any order and
+   * possibly concurrently, and returns when all calls have finished.
+   */
+  virtual void ForEach(Job &job, unsigned n) = 0;
+};
+
 class ReachFan {
   TaskProjection task_proj;
   FlatTriangleFanTree root;
   short terrain_base;
 
+  /** Whether the members below describe the current fan */
+  bool solved;
+  /** Origin of the current fan */
+  GeoPoint origin_solved;
+  /** Origin altitude (m) of the current fan */
+  short h_solved;
+  /** Whether the current fan was scanned rather than a dummy */
+  bool do_solve_solved;
+  /** Terrain of the current fan */
+  const RasterMap *terrain_solved;
+  /** RasterMap serial of the current fan */
+  unsigned terrain_serial;
+  /** Return value of solve() for the current fan */
+  bool result_solved;
+
+  /** Traces the rays of the root fan, or NULL to trace them serially */
+  ParallelRunner *runner;
+
 public:
-  ReachFan():terrain_base(0) {};
+  ReachFan():terrain_base(0), solved(false), runner(NULL) {};
 
   friend class PrintHelper;
 
   void reset();
 
+  /**
+   * Set the runner used to trace the rays of the root fan.  The
+   * rays are traced while the caller holds the terrain, so the
+   * runner's jobs must have finished when ForEach() returns.
+   */
+  void set_runner(ParallelRunner *_runner) {
+    runner = _runner;
+  }
+
   bool solve(const AGeoPoint origin,
              const RoutePolars &rpolars,
              const RasterMap *terrain,
              const bool do_solve=true);
 
+  /**
+   * Call solve(), unless the current fan was generated from the same
+   * origin and terrain.  Changes of the polars are not detected, the
+   * caller must call invalidate() after them.
+   *
+   * @param changed Set to true if the fan was generated again
+   *
+   * @return The result of solve() for the current fan
+   */
+  bool update(const AGeoPoint origin,
+              const RoutePolars &rpolars,
+              const RasterMap *terrain,
+              const bool do_solve,
+              bool &changed);
+
+  /**
+   * Make the next update() generate the fan again, but keep the
+   * current one until then.
+   */
+  void invalidate() {
+    solved = false;
+  }
+
   bool find_positive_arrival(const AGeoPoint dest,
                              const RoutePolars &rpolars,
                              short& arrival_height_reach,
@@ -26,16 +26,19 @@
 #include "Math/FastMath.h"
 #include "Navigation/ConvexHull/PolygonInterior.hpp"
 
+const fixed RoutePlanner::PROJECTION_RANGE(20000);
+
 RoutePlanner::RoutePlanner(const GlidePolar& polar,
                            const SpeedVector& wind):
   rpolars_route(polar, wind),
   rpolars_reach(polar, wind),
+  rpolars_reach_solved(polar, wind),
   terrain(NULL),
   m_planner(0),
-  m_reach_polar_mode(RoutePlannerConfig::rpmTask)
-#ifndef PLANNER_SET
-  , m_unique(50000)
-#endif
+  clearance_bounds(FlatGeoPoint(0, 0), FlatGeoPoint(0, 0)),
+  reach_serial(0),
+  m_reach_polar_mode(RoutePlannerConfig::rpmTask),
+  count_expanded(0)
 {
   reset();
 }
@@ -52,7 +55,15 @@ RoutePlanner::reset()
   h_min = (short)-1;
   h_max = 0;
   m_search_hull.clear();
+  projection_valid = false;
+  m_clearance.clear();
+  clearance_center = GeoPoint(Angle::native(fixed_zero),
+                              Angle::native(fixed_zero));
+  clearance_serial = 0;
+  clearance_ceiling = -1;
+  clearance_safety = -1;
   reach.reset();
+  ++reach_serial;
 }
 
 void
@@ -64,7 +75,19 @@ RoutePlanner::get_solution(Route& route) const
 bool
 RoutePlanner::solve_reach(const AGeoPoint& origin, const bool do_solve)
 {
-  return reach.solve(origin, rpolars_reach, terrain, do_solve);
+  // polars are updated every cycle, the fan only needs to be
+  // generated again if they changed in a way that affects it
+  if (!rpolars_reach.reach_equivalent(rpolars_reach_solved)) {
+    rpolars_reach_solved = rpolars_reach;
+    reach.invalidate();
+  }
+
+  bool changed;
+  const bool retval = reach.update(origin, rpolars_reach, terrain, do_solve,
+                                   changed);
+  if (changed)
+    ++reach_serial;
+  return retval;
 }
 
 bool
@@ -81,6 +104,8 @@ RoutePlanner::solve(const AGeoPoint& origin,
 
   m_reach_polar_mode = config.reach_polar_mode;
 
+  validate_clearance_cache();
+
   {
     const AFlatGeoPoint s_origin(task_projection.project(origin), origin.altitude);
     const AFlatGeoPoint s_destination(task_projection.project(destination), destination.altitude);
@@ -119,9 +144,20 @@ RoutePlanner::solve(const AGeoPoint& origin,
     return false;
 
   count_dij=0;
+  count_expanded=0;
   count_airspace=0;
   count_terrain=0;
   count_supressed=0;
+  count_terrain_cached=0;
+
+  // size the hash tables from the extent of the search; the number of
+  // links and nodes visited grows roughly with the direct distance
+  const unsigned reserve =
+    std::min(std::max(e_test.distance() * ROUTE_RESERVE_PER_UNIT,
+                      (unsigned)ASTAR_QUEUE_SIZE),
+             (unsigned)ROUTE_RESERVE_MAX);
+  m_unique.reserve(reserve);
+  m_planner.reserve_nodes(reserve);
 
   bool retval = false;
   m_planner.restart(start);
@@ -130,6 +166,7 @@ RoutePlanner::solve(const AGeoPoint& origin,
 
   while (!m_planner.empty()) {
     const RoutePoint node = m_planner.pop();
+    count_expanded++;
 
     h_min = std::min(h_min, node.altitude);
     h_max = std::max(h_max, node.altitude);
@@ -284,10 +321,8 @@ RoutePlanner::link_cleared(const RouteLink &e)
 bool
 RoutePlanner::set_unique(const RouteLinkBase &e)
 {
-  if (m_unique.find(e) == m_unique.end()) {
-    m_unique.insert(e);
+  if (m_unique.insert(e).second)
     return true;
-  }
   count_supressed++;
   return false;
 }
@@ -372,6 +407,8 @@ RoutePlanner::update_polar(const GlidePolar& task_polar,
                            const GlidePolar& safety_polar,
                            const SpeedVector& wind)
 {
+  const RoutePolars previous = rpolars_reach;
+
   rpolars_route.initialise(task_polar, wind);
   switch (m_reach_polar_mode) {
   case RoutePlannerConfig::rpmTask:
@@ -384,6 +421,9 @@ RoutePlanner::update_polar(const GlidePolar& task_polar,
     glide_polar_reach = safety_polar;
     break;
   }
+
+  if (!rpolars_reach.reach_equivalent(previous))
+    ++reach_serial;
 }
 
 /*
@@ -398,12 +438,67 @@ RoutePlanner::check_clearance_terrain(const RouteLink &e, RoutePoint& inp) const
 {
   if (!terrain || !terrain->isMapLoaded())
     return true;
+  if (!rpolars_route.terrain_enabled())
+    return true;
+
+  const short vh = rpolars_route.calc_vheight(e);
+  const unsigned i = m_clearance.find(e);
+  if (i != ClearanceCache::NONE && m_clearance[i].second.vheight == vh) {
+    count_terrain_cached++;
+    if (m_clearance[i].second.clear)
+      return true;
+    inp = m_clearance[i].second.intercept;
+    return false;
+  }
+
   count_terrain++;
-  if (rpolars_route.check_clearance(e, terrain, task_projection, inp))
+  ClearanceResult result;
+  result.vheight = vh;
+  result.clear = rpolars_route.check_clearance(e, terrain, task_projection,
+                                               result.intercept);
+
+  if (i != ClearanceCache::NONE)
+    m_clearance[i].second = result;
+  else {
+    if (m_clearance.size() >= CLEARANCE_CACHE_SIZE)
+      m_clearance.clear();
+
+    if (m_clearance.empty())
+      clearance_bounds = FlatBoundingBox(e.first, e.first);
+    else
+      clearance_bounds.expand(e.first);
+    clearance_bounds.expand(e.second);
+
+    m_clearance.insert(std::make_pair(RouteLinkBase(e), result));
+  }
+
+  if (result.clear)
     return true;
+  inp = result.intercept;
   return false;
 }
 
+void
+RoutePlanner::validate_clearance_cache()
+{
+  const short safety = rpolars_route.safety_height();
+
+  if (!(task_projection.get_center() == clearance_center) ||
+      rpolars_route.climb_ceiling != clearance_ceiling ||
+      safety != clearance_safety) {
+    m_clearance.clear();
+    clearance_center = task_projection.get_center();
+    clearance_ceiling = rpolars_route.climb_ceiling;
+    clearance_safety = safety;
+  } else if (terrain != NULL && !m_clearance.empty() &&
+             terrain->GetSerial(task_projection.unproject(clearance_bounds))
+             > clearance_serial)
+    /* tiles below the cached links were loaded or discarded */
+    m_clearance.clear();
+
+  clearance_serial = terrain ? terrain->GetSerial() : 0;
+}
+
 void
 RoutePlanner::add_nearby_terrain_sweep(const RoutePoint& p, const RouteLink &c_link, const int sign)
 {
@@ -476,8 +571,22 @@ void
 RoutePlanner::on_solve(const AGeoPoint& origin,
                        const AGeoPoint& destination)
 {
+  anchor_projection(origin);
+}
+
+void
+RoutePlanner::anchor_projection(const GeoPoint &origin)
+{
+  /* keep the projection while the origin stays near its center, so
+     that route points keep their flat coordinates between solutions
+     and remembered clearance checks remain valid */
+  if (projection_valid &&
+      task_projection.get_center().distance(origin) < PROJECTION_RANGE)
+    return;
+
   task_projection.reset(origin);
   task_projection.update_fast();
+  projection_valid = true;
 }
 
 bool
@@ -512,7 +621,6 @@ RoutePlanner::intersection(const AGeoPoint& origin,
   - promote stable solutions with rounding of time value
   - adjustment to GlideSolution height/time in task manager according to path
     variation required for terrain/airspace avoidance
-  - tr1::hash function portability between compiler versions
   - AirspaceRoute synchronise method to disable/ignore airspaces that are
     acknowledged in the airspace warning manager.
   - more documentation
@@ -30,34 +30,38 @@
 #include <algorithm>
 #include "Navigation/TaskProjection.hpp"
 #include "Navigation/SearchPointVector.hpp"
+#include "Navigation/Flat/FlatBoundingBox.hpp"
 #include "ReachFan.hpp"
 
-// define PLANNER_SET if STL tr1 extensions are not to be used
-// (with performance penalty)
-#define PLANNER_SET
-
-#ifdef PLANNER_SET
-#include <set>
-#else
-#include <tr1/unordered_set>
-#include <tr1/unordered_map>
-
-namespace std
-{
-    namespace tr1
-    {
-        template <>
-        struct hash<RouteLinkBase> : public unary_function<RouteLinkBase, size_t>
-        {
-          gcc_pure
-          size_t operator()(const RouteLinkBase& __val) const {
-            return std::tr1::_Fnv_hash<sizeof(size_t)>::hash ((const char*)&__val, sizeof(__val));
-          }
-        };
-    }
-}
+#include "Util/OpenHash.hpp"
 
-#endif
+/** Hash table capacity reserved per flat unit of direct route distance */
+#define ROUTE_RESERVE_PER_UNIT 8
+/** Maximum hash table capacity reserved for a route solution */
+#define ROUTE_RESERVE_MAX 65536
+
+/**
+ * Hash function for route nodes, used by the A* node map
+ */
+struct RoutePointHash {
+  gcc_pure
+  unsigned operator()(const RoutePoint &p) const {
+    return open_hash_mix((unsigned)p.Longitude * 0x9e3779b1u +
+                         (unsigned)p.Latitude * 0x7feb352du +
+                         (unsigned)p.altitude);
+  }
+};
+
+/**
+ * Hash function for route links, used for the set of visited links
+ */
+struct RouteLinkHash {
+  gcc_pure
+  unsigned operator()(const RouteLinkBase &l) const {
+    const RoutePointHash h;
+    return h(l.first) * 31u + h(l.second);
+  }
+};
 
 /**
  * A Route is a vector of AGeoPoints.
@@ -114,25 +118,64 @@ protected:
 
   bool dirty; /**< Whether an updated solution is required */
   TaskProjection task_projection; /**< Task projection used for flat-earth representation */
+  bool projection_valid; /**< Whether task_projection has been initialised */
   RoutePolars rpolars_route; /**< Aircraft performance model */
   RoutePolars rpolars_reach; /**< Aircraft performance model */
+  RoutePolars rpolars_reach_solved; /**< Performance model of the current reach */
   const RasterMap *terrain; /**< Terrain raster */
   short h_min; /**< Minimum height scanned during solution (m) */
   short h_max; /**< Maxmimum height scanned during solution (m) */
   GlidePolar glide_polar_reach;
 
 private:
-  AStar<RoutePoint> m_planner; /**< A* search algorithm */
+  AStar<RoutePoint, RoutePointHash> m_planner; /**< A* search algorithm */
   SearchPointVector m_search_hull; /**< Convex hull of search to date,
                                     used by terrain node generator to prevent
                                     backtracking */
 
-#ifdef PLANNER_SET
-  typedef std::set< RouteLinkBase> RouteLinkSet;
-#else
-  typedef std::tr1::unordered_set< RouteLinkBase > RouteLinkSet;
-#endif
+  typedef OpenHashSet<RouteLinkBase, RouteLinkHash> RouteLinkSet;
   RouteLinkSet m_unique; /**<  Links that have been visited during solution */
+
+  /**
+   * Remembered outcome of a terrain clearance check of one link
+   */
+  struct ClearanceResult {
+    short vheight; /**< Glide height of the link when checked (m) */
+    bool clear; /**< Whether the link cleared terrain */
+    RoutePoint intercept; /**< Clearance point if not clear */
+  };
+
+  typedef OpenHashMap<RouteLinkBase, ClearanceResult,
+                      RouteLinkHash> ClearanceCache;
+  /**
+   * Distance (m) the origin may move from the projection center
+   * before the projection is moved
+   */
+  static const fixed PROJECTION_RANGE;
+
+  /** Maximum number of links remembered in the clearance cache */
+  static const unsigned CLEARANCE_CACHE_SIZE = 20000;
+
+  /**
+   * Terrain clearance checks kept between calls to solve(), so that
+   * successive solutions with the same projection reuse terrain scans
+   * of links that were already evaluated.
+   */
+  mutable ClearanceCache m_clearance;
+  /** Flat area covered by the links in m_clearance */
+  mutable FlatBoundingBox clearance_bounds;
+  /** Projection center for which m_clearance is valid */
+  GeoPoint clearance_center;
+  /**
+   * RasterMap serial when m_clearance was last validated; tiles in
+   * #clearance_bounds changed after that invalidate it
+   */
+  unsigned clearance_serial;
+  /** Climb ceiling (m) for which m_clearance is valid */
+  short clearance_ceiling;
+  /** Terrain safety height (m) for which m_clearance is valid */
+  short clearance_safety;
+
   typedef std::queue< RouteLink> RouteLinkQueue;
   RouteLinkQueue m_links; /**< Link candidates to be processed for intersection
                            * tests */
@@ -144,11 +187,20 @@ private:
 
   ReachFan reach;
 
+  /**
+   * Incremented whenever the reach fan or the polar it is evaluated
+   * with may have changed, i.e. whenever results of
+   * find_positive_arrival() may differ from earlier ones.
+   */
+  unsigned reach_serial;
+
   RoutePlannerConfig::PolarMode m_reach_polar_mode;
 
   mutable unsigned long count_dij;
+  unsigned long count_expanded;
   mutable unsigned long count_unique;
   mutable unsigned long count_supressed;
+  mutable unsigned long count_terrain_cached;
 
 protected:
   RoutePoint m_astar_goal;
@@ -175,6 +227,8 @@ public:
    */
   void set_terrain(const RasterMap* _terrain) {
     terrain = _terrain;
+    m_clearance.clear();
+    ++reach_serial;
   }
 
   /**
@@ -204,6 +258,14 @@ public:
    */
   bool solve_reach(const AGeoPoint& origin, const bool do_solve=true);
 
+  /**
+   * Set the runner which traces the rays of the reach fan's root in
+   * parallel, see ReachFan::set_runner().
+   */
+  void set_reach_runner(ParallelRunner *runner) {
+    reach.set_runner(runner);
+  }
+
   /**
    * Visit reach
    */
@@ -268,6 +330,15 @@ public:
                                        arrival_height_direct);
   }
 
+  /**
+   * Returns a number which is incremented whenever the results of
+   * find_positive_arrival() may have changed.  Callers may cache
+   * arrival heights as long as this number stays the same.
+   */
+  unsigned get_reach_serial() const {
+    return reach_serial;
+  }
+
   const GlidePolar& get_reach_polar() const {
     return glide_polar_reach;
   }
@@ -276,7 +347,30 @@ public:
     return reach.get_terrain_base();
   }
 
+  /**
+   * Return the number of nodes expanded by the last call to solve()
+   */
+  unsigned long get_count_expanded() const {
+    return count_expanded;
+  }
+
+  /**
+   * Return the number of terrain clearance checks answered from the
+   * cache by the last call to solve()
+   */
+  unsigned long get_count_terrain_cached() const {
+    return count_terrain_cached;
+  }
+
 protected:
+  /**
+   * Initialise the projection at the origin, unless the origin is
+   * still within #PROJECTION_RANGE of the current projection center.
+   *
+   * @param origin origin of search
+   */
+  void anchor_projection(const GeoPoint &origin);
+
   /**
    * Test whether a solution is required or the solution is trivial
    * (too short, etc.)
@@ -426,6 +520,12 @@ private:
    */
   bool hull_extended(const RoutePoint& p);
 
+  /**
+   * Discard remembered terrain clearance checks if the projection,
+   * terrain or clearance parameters changed since they were made.
+   */
+  void validate_clearance_cache();
+
   /**
    * Backtrack solution from A* internal structure to construct a
    * Route.
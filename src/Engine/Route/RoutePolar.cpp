@@ -38,6 +38,19 @@ RoutePolar::RoutePolar(const RoutePolar& from)
   std::copy(from.points, from.points+ ROUTEPOLAR_POINTS, points);
 }
 
+bool
+RoutePolar::operator==(const RoutePolar& other) const
+{
+  for (unsigned i = 0; i < ROUTEPOLAR_POINTS; ++i) {
+    const RoutePolarPoint &a = points[i];
+    const RoutePolarPoint &b = other.points[i];
+    if (a.valid != b.valid || a.slowness != b.slowness ||
+        a.gradient != b.gradient)
+      return false;
+  }
+  return true;
+}
+
 GlideResult
 RoutePolar::solve_task(const GlidePolar& glide_polar,
                        const SpeedVector& wind,
@@ -365,6 +378,14 @@ RoutePolars::set_config(const RoutePlannerConfig& _config,
   }
 }
 
+bool
+RoutePolars::reach_equivalent(const RoutePolars& other) const
+{
+  return safety_height() == other.safety_height() &&
+    turning_reach() == other.turning_reach() &&
+    polar_glide == other.polar_glide;
+}
+
 bool
 RoutePolars::can_climb() const {
   return config.allow_climb && positive(inv_M);
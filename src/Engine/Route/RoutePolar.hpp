@@ -255,6 +255,16 @@ public:
    */
   static void index_to_dxdy(const int index, int& dx, int& dy);
 
+  /**
+   * Check whether two performance tables hold the same data.
+   *
+   * @param other Table to compare with
+   *
+   * @return True if all directions have equal performance
+   */
+  gcc_pure
+  bool operator==(const RoutePolar& other) const;
+
 private:
   GlideResult solve_task(const GlidePolar& polar, const SpeedVector& wind,
                          const Angle theta, const bool glide) const;
@@ -451,6 +461,17 @@ public:
     return (short)config.safety_height_terrain;
   }
 
+  /**
+   * Check whether reach calculations with another performance model
+   * would give the same result as with this one.
+   *
+   * @param other Performance model to compare with
+   *
+   * @return True if glide performance and reach settings are equal
+   */
+  gcc_pure
+  bool reach_equivalent(const RoutePolars& other) const;
+
   FlatGeoPoint reach_intercept(const int index,
                                const AGeoPoint& p,
                                const RasterMap* map,
@@ -25,17 +25,10 @@ Copyright_License {
 #define ASTAR_HPP
 
 #include "Util/queue.hpp"
+#include "Util/OpenHash.hpp"
 #include <assert.h>
 #include "Compiler.h"
 
-//#define ASTAR_TR1
-
-#ifdef ASTAR_TR1
-#include <tr1/unordered_map>
-#else
-#include <map>
-#endif
-
 #ifdef INSTRUMENT_TASK
 extern long count_astar_links;
 #endif
@@ -78,8 +71,10 @@ struct AStarPriorityValue {
  * AStar search algorithm, based on Dijkstra algorithm
  * Modifications by John Wharington to track optimal solution
  * @see http://en.giswiki.net/wiki/Dijkstra%27s_algorithm
+ *
+ * The Hash class must provide "unsigned operator()(const Node &) const".
  */
-template <class Node, bool m_min=true>
+template <class Node, class Hash, bool m_min=true>
 class AStar {
 public:
 
@@ -89,6 +84,7 @@ public:
    * @param is_min Whether this algorithm will search for min or max distance
    */
   AStar(unsigned reserve_default=ASTAR_QUEUE_SIZE)
+    :cur(NodeMap::NONE)
   {
     reserve(reserve_default);
   }
@@ -100,9 +96,10 @@ public:
    * @param is_min Whether this algorithm will search for min or max distance
    */
   AStar(const Node &node, unsigned reserve_default=ASTAR_QUEUE_SIZE)
+    :cur(NodeMap::NONE)
   {
-    push(node, node, AStarPriorityValue(0));
     reserve(reserve_default);
+    push(node, node, AStarPriorityValue(0));
   }
 
   /**
@@ -123,10 +120,9 @@ public:
     while (!q.empty())
       q.pop();
 
-    // Clear the node_parent_map
-    node_parents.clear();
-    // Clear the node_value_map
-    node_values.clear();
+    // Clear the node map
+    nodes.clear();
+    cur = NodeMap::NONE;
   }
 
   /**
@@ -154,15 +150,15 @@ public:
    *
    * @return Node for processing
    */
-  const Node &pop() {
+  Node pop() {
     cur = q.top().second;
 
     do // remove this item
       q.pop();
-    while (!q.empty() && (q.top().first > q.top().second->second));
+    while (!q.empty() && (q.top().first > nodes[q.top().second].second.value));
     // and all lower rank than this
 
-    return cur->first;
+    return nodes[cur].first;
   }
 
   /**
@@ -189,9 +185,9 @@ public:
    */
   gcc_pure
   Node get_predecessor(const Node &node) const {
-    // Try to find the given node in the node_parent_map
-    node_parent_const_iterator it = node_parents.find(node);
-    if (it == node_parents.end())
+    // Try to find the given node in the node map
+    const unsigned i = nodes.find(node);
+    if (i == NodeMap::NONE)
       // first entry
       // If the node wasn't found
       // -> Return the given node itself
@@ -199,7 +195,7 @@ public:
     else
       // If the node was found
       // -> Return the parent node
-      return (it->second);
+      return nodes[i].second.parent;
   }
 
   /**
@@ -209,19 +205,36 @@ public:
     q.reserve(size);
   }
 
+  /**
+   * Reserve space for the specified number of nodes, so that the
+   * node map does not need to grow during the search
+   */
+  void reserve_nodes(unsigned size) {
+    nodes.reserve(size);
+  }
+
+  /**
+   * Return number of distinct nodes visited so far
+   */
+  gcc_pure
+  unsigned node_count() const {
+    return nodes.size();
+  }
+
   /**
    * Obtain the value of this node (accumulated distance to this node)
    * Returns 0 on failure to find the node.
    */
   gcc_pure
   AStarPriorityValue get_node_value(const Node &node) const {
-    node_value_const_iterator it = node_values.find(node);
-    if (cur->first == node)
-      return cur->second;
-    if (it == node_values.end()) {
+    if (cur != NodeMap::NONE && nodes[cur].first == node)
+      return nodes[cur].second.value;
+
+    const unsigned i = nodes.find(node);
+    if (i == NodeMap::NONE) {
       return AStarPriorityValue(0);
     } else {
-      return it->second;
+      return nodes[i].second.value;
     }
   }
 
@@ -236,65 +249,40 @@ private:
    */
   void push(const Node &node, const Node &parent,
             const AStarPriorityValue &edge_value) {
-    // Try to find the given node n in the node_value_map
-    node_value_iterator it = node_values.find(node);
-    if (it == node_values.end()) {
-      // first entry
-      // If the node wasn't found
-      // -> Insert a new node into the node_value_map
-      it = node_values.insert(std::make_pair(node, edge_value)).first;
+    // Try to find the given node n in the node map, inserting it if
+    // not present
+    const std::pair<unsigned, bool> result =
+      nodes.insert(std::make_pair(node, NodeInfo(edge_value, parent)));
+    if (!result.second) {
+      NodeInfo &info = nodes[result.first].second;
+      if (!(info.value > edge_value))
+        // If the node was found but the value is higher or equal
+        // -> Don't use this new leg
+        return;
 
-      // Remember the parent node
-      set_predecessor(node, parent);
-    } else if (it->second > edge_value) {
       // If the node was found and the new value is smaller
-      // -> Replace the value with the new one
-      it->second = edge_value;
-      // replace, it's bigger
-
-      // Remember the new parent node
-      set_predecessor(node, parent);
-    } else
-      // If the node was found but the value is higher or equal
-      // -> Don't use this new leg
-      return;
-
-    q.push(std::make_pair(edge_value, it));
-  }
+      // -> Replace the value and the parent node with the new ones
+      info.value = edge_value;
+      info.parent = parent;
+    }
 
-  void set_predecessor(const Node &node, const Node &parent) {
-    // Try to find the given node in the node_parent_map
-    node_parent_iterator it = node_parents.find(node);
-    if (it == node_parents.end())
-      // first entry
-      // If the node wasn't found
-      // -> Insert a new node into the node_parent_map
-      node_parents.insert(std::make_pair(node, parent));
-    else
-      // If the node was found
-      // -> Replace the according parent node with the new one
-      it->second = parent;
+    q.push(std::make_pair(edge_value, result.first));
   }
 
-#ifdef ASTAR_TR1
-  typedef std::tr1::unordered_map<Node, AStarPriorityValue> node_value_map;
-#else
-  typedef std::map<Node, AStarPriorityValue> node_value_map;
-#endif
-
-  typedef typename node_value_map::iterator node_value_iterator;
-  typedef typename node_value_map::const_iterator node_value_const_iterator;
+  /**
+   * Value and best predecessor of a node
+   */
+  struct NodeInfo {
+    NodeInfo(const AStarPriorityValue &_value, const Node &_parent)
+      :value(_value), parent(_parent) {}
 
-#ifdef ASTAR_TR1
-  typedef std::tr1::unordered_map<Node, Node> node_parent_map;
-#else
-  typedef std::map<Node, Node> node_parent_map;
-#endif
+    AStarPriorityValue value;
+    Node parent;
+  };
 
-  typedef typename node_parent_map::iterator node_parent_iterator;
-  typedef typename node_parent_map::const_iterator node_parent_const_iterator;
+  typedef OpenHashMap<Node, NodeInfo, Hash> NodeMap;
 
-  typedef std::pair<AStarPriorityValue, node_value_iterator> NodeValue;
+  typedef std::pair<AStarPriorityValue, unsigned> NodeValue;
 
   struct Rank : public std::binary_function<NodeValue, NodeValue, bool> {
     gcc_pure
@@ -304,23 +292,18 @@ private:
   };
 
   /**
-   * Stores the value of each node.  It is updated by push(), if a
-   * value lower than the current one is found.
-   */
-  node_value_map node_values;
-
-  /**
-   * Stores the predecessor of each node.  It is maintained by
-   * set_predecessor().
+   * Stores the value and predecessor of each node.  It is updated by
+   * push(), if a value lower than the current one is found.
    */
-  node_parent_map node_parents;
+  NodeMap nodes;
 
   /**
    * A sorted list of all possible node paths, lowest distance first.
    */
   reservable_priority_queue<NodeValue, std::vector<NodeValue>, Rank> q;
 
-  node_value_iterator cur;
+  /** Index of the node last returned by pop() */
+  unsigned cur;
 };
 
 #endif
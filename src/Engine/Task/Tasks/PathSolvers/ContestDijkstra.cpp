@@ -29,10 +29,6 @@ Copyright_License {
 #include <assert.h>
 #include <limits.h>
 
-unsigned long ContestDijkstra::count_olc_solve = 0;
-unsigned long ContestDijkstra::count_olc_trace = 0;
-unsigned ContestDijkstra::count_olc_size = 0;
-
 // set size of reserved queue elements (may differ from Dijkstra default)
 #define CONTEST_QUEUE_SIZE DIJKSTRA_QUEUE_SIZE
 
@@ -131,9 +131,9 @@ private:
   bool master_is_updated();
 
 public: // instrumentation
-  static unsigned long count_olc_solve;
-  static unsigned long count_olc_trace;
-  static unsigned count_olc_size;
+  unsigned long count_olc_solve;
+  unsigned long count_olc_trace;
+  unsigned count_olc_size;
 };
 
 #endif
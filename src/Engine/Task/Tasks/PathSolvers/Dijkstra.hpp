@@ -139,7 +139,7 @@ public:
    */
   void link(const Node &node, const Node &parent, const unsigned &edge_value = 1) {
 #ifdef INSTRUMENT_TASK
-    count_dijkstra_links++;
+    __sync_fetch_and_add(&count_dijkstra_links, 1);
 #endif
     push(node, parent, cur->second + adjust_edge_value(edge_value)); 
   }
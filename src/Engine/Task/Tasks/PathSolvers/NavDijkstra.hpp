@@ -165,7 +165,7 @@ protected:
    */
   bool distance_general(unsigned max_steps = 0 - 1) {
 #ifdef INSTRUMENT_TASK
-    count_dijkstra_queries++;
+    __sync_fetch_and_add(&count_dijkstra_queries, 1);
 #endif
 
     while (!dijkstra.empty()) {
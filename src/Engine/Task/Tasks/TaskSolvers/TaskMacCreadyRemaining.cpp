@@ -41,7 +41,32 @@ TaskMacCreadyRemaining::tp_solution(const unsigned i,
                                     const AIRCRAFT_STATE &aircraft, 
                                     fixed minH) const
 {
-  return TaskSolution::glide_solution_remaining(*m_tps[i],aircraft, m_glide_polar, minH);
+  if (m_leg_cache.empty())
+    return TaskSolution::glide_solution_remaining(*m_tps[i], aircraft,
+                                                  m_glide_polar, minH);
+
+  const GeoVector vector = m_tps[i]->get_vector_remaining(aircraft);
+  LegCache &cache = m_leg_cache[i];
+  for (unsigned j = 0; j < LEG_CACHE_SLOTS; ++j)
+    if (cache.slots[j].matches(vector, aircraft.NavAltitude, minH))
+      return cache.slots[j].result;
+
+  LegCacheSlot &slot = cache.slots[cache.next];
+  cache.next = (cache.next + 1) % LEG_CACHE_SLOTS;
+
+  slot.result = TaskSolution::glide_solution_remaining(*m_tps[i], aircraft,
+                                                       m_glide_polar, minH);
+  slot.vector = vector;
+  slot.altitude = aircraft.NavAltitude;
+  slot.min_height = minH;
+  slot.valid = true;
+  return slot.result;
+}
+
+void
+TaskMacCreadyRemaining::enable_leg_cache()
+{
+  m_leg_cache.assign(m_tps.size(), LegCache());
 }
 
 
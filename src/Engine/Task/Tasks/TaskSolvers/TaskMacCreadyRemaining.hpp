@@ -75,7 +75,54 @@ public:
  */
     void target_restore();
 
+/**
+ * Enable memoisation of leg glide solutions.
+ *
+ * Target optimisers probe many target positions, but each probe only
+ * changes the geometry of the legs adjacent to the moved targets.  With
+ * the cache enabled, legs whose vector, start altitude and minimum
+ * height are unchanged since a previous probe reuse that solution
+ * instead of re-solving MacCready.
+ *
+ * The glide polar and the aircraft wind must not change while the
+ * cache is enabled.
+ */
+  void enable_leg_cache();
+
 private:
+  /** Number of remembered solutions per leg */
+  static const unsigned LEG_CACHE_SLOTS = 2;
+
+  /**
+   * Memoised solution of a leg, keyed on the inputs of the glide state
+   */
+  struct LegCacheSlot {
+    bool valid;
+    GeoVector vector;
+    fixed altitude;
+    fixed min_height;
+    GlideResult result;
+
+    LegCacheSlot():valid(false) {}
+
+    bool matches(const GeoVector &_vector, const fixed _altitude,
+                 const fixed _min_height) const {
+      return valid && vector.Distance == _vector.Distance &&
+        vector.Bearing == _vector.Bearing &&
+        altitude == _altitude && min_height == _min_height;
+    }
+  };
+
+  struct LegCache {
+    LegCacheSlot slots[LEG_CACHE_SLOTS];
+    unsigned next; /**< Slot to be replaced on the next miss */
+
+    LegCache():next(0) {}
+  };
+
+  /** Per-leg solution cache; empty if disabled */
+  mutable std::vector<LegCache> m_leg_cache;
+
 
   virtual GlideResult tp_solution(const unsigned i,
                                    const AIRCRAFT_STATE &aircraft, 
@@ -37,6 +37,7 @@ TaskMinTarget::TaskMinTarget(const std::vector<OrderedTaskPoint*>& tps,
   tp_start(_ts),
   force_current(false)
 {
+  tm.enable_leg_cache();
 
 }
 
@@ -37,6 +37,7 @@ TaskOptTarget::TaskOptTarget(const std::vector<OrderedTaskPoint*>& tps,
   tp_current(_tp_current),
   iso(_tp_current, projection)
 {
+  tm.enable_leg_cache();
 
 }
 
@@ -32,7 +32,8 @@ Trace::Trace(const unsigned _no_thin_time, const unsigned max_time,
    m_max_time(max_time),
    no_thin_time(_no_thin_time),
    m_max_points(max_points),
-   m_opt_points((3*max_points)/4)
+   m_opt_points((3*max_points)/4),
+   serial(0)
 {
   assert(max_points >= 4);
 }
@@ -49,6 +50,7 @@ Trace::clear()
   delta_list.clear();
   chronological_list.Clear();
   cached_size = 0;
+  ++serial;
 
   assert(cached_size == delta_list.size());
   assert(cached_size == chronological_list.Count());
@@ -232,6 +234,7 @@ Trace::append(const AIRCRAFT_STATE& state)
   td.InsertBefore(chronological_list);
 
   ++cached_size;
+  ++serial;
 
   if (!chronological_list.IsFirst(td))
     update_delta(td.GetPrevious());
@@ -318,6 +321,7 @@ Trace::optimise_if_old()
 
   m_average_delta_distance = calc_average_delta_distance(no_thin_time);
   m_average_delta_time = calc_average_delta_time(no_thin_time);
+  ++serial;
 
   return true;
 }
@@ -200,6 +200,9 @@ class Trace : private NonCopyable
   unsigned m_average_delta_time;
   unsigned m_average_delta_distance;
 
+  /** Incremented whenever points are added or removed */
+  unsigned serial;
+
 public:
   /**
    * Constructor.  Task projection is updated after first call to append().
@@ -314,6 +317,15 @@ public:
     return chronological_list.IsEmpty();
   }
 
+  /**
+   * Returns a number which changes whenever points are added or
+   * removed.  Renderers may use it to decide whether a copy of the
+   * trace is still current.
+   */
+  unsigned GetSerial() const {
+    return serial;
+  }
+
   /**
    * Re-balance kd-tree periodically 
    *
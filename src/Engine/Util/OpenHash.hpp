@@ -0,0 +1,232 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef OPEN_HASH_HPP
+#define OPEN_HASH_HPP
+
+#include "Compiler.h"
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <assert.h>
+
+/**
+ * Hash table with open addressing (linear probing).  The elements are
+ * stored densely in insertion order, the probe table only holds
+ * element indices.  An element's index therefore remains valid until
+ * the table is cleared, even when the table grows.
+ *
+ * Elements cannot be removed individually; the table is meant to be
+ * filled during one search and cleared afterwards, which keeps the
+ * allocated capacity.
+ *
+ * @param T element type
+ * @param Key key type
+ * @param KeyOf functor returning the key of an element
+ * @param Hash functor returning an unsigned hash of a key
+ */
+template<class T, class Key, class KeyOf, class Hash>
+class OpenHashTable {
+public:
+  /** Index returned by find() if the key is not present */
+  static const unsigned NONE = (unsigned)-1;
+
+private:
+  std::vector<T> elements;
+
+  /** Probe table; element index plus one, or zero for empty slots */
+  std::vector<unsigned> table;
+
+  unsigned mask;
+
+  KeyOf key_of;
+  Hash hash;
+
+public:
+  OpenHashTable(unsigned reserve_default = 0):mask(0) {
+    reserve(reserve_default);
+  }
+
+  /**
+   * Removes all elements, keeping the allocated capacity.
+   */
+  void clear() {
+    elements.clear();
+    std::fill(table.begin(), table.end(), 0u);
+  }
+
+  gcc_pure
+  bool empty() const {
+    return elements.empty();
+  }
+
+  gcc_pure
+  unsigned size() const {
+    return elements.size();
+  }
+
+  /**
+   * Make room for the specified number of elements, so that they can
+   * be inserted without growing the probe table.
+   */
+  void reserve(unsigned n) {
+    elements.reserve(n);
+
+    /* keep the load factor at or below 1/2 */
+    unsigned size = 16;
+    while (size < n * 2)
+      size <<= 1;
+
+    if (size > table.size())
+      rehash(size);
+  }
+
+  /**
+   * Look up a key.
+   *
+   * @return the index of the element, or NONE if not found
+   */
+  gcc_pure
+  unsigned find(const Key &key) const {
+    if (table.empty())
+      return NONE;
+
+    for (unsigned slot = hash(key) & mask;; slot = (slot + 1) & mask) {
+      const unsigned i = table[slot];
+      if (i == 0)
+        return NONE;
+      if (key_of(elements[i - 1]) == key)
+        return i - 1;
+    }
+  }
+
+  /**
+   * Insert an element unless one with the same key exists already.
+   *
+   * @return the index of the element with this key, and true if the
+   * element was inserted
+   */
+  std::pair<unsigned, bool> insert(const T &element) {
+    if ((elements.size() + 1) * 2 > table.size())
+      rehash(std::max(16u, (unsigned)table.size() * 2));
+
+    const Key &key = key_of(element);
+    unsigned slot = hash(key) & mask;
+    for (;; slot = (slot + 1) & mask) {
+      const unsigned i = table[slot];
+      if (i == 0)
+        break;
+      if (key_of(elements[i - 1]) == key)
+        return std::make_pair(i - 1, false);
+    }
+
+    elements.push_back(element);
+    table[slot] = elements.size();
+    return std::make_pair((unsigned)elements.size() - 1, true);
+  }
+
+  T &operator[](unsigned i) {
+    assert(i < elements.size());
+    return elements[i];
+  }
+
+  const T &operator[](unsigned i) const {
+    assert(i < elements.size());
+    return elements[i];
+  }
+
+private:
+  void rehash(unsigned size) {
+    assert((size & (size - 1)) == 0);
+
+    table.assign(size, 0u);
+    mask = size - 1;
+
+    for (unsigned i = 0; i < elements.size(); ++i) {
+      unsigned slot = hash(key_of(elements[i])) & mask;
+      while (table[slot] != 0)
+        slot = (slot + 1) & mask;
+      table[slot] = i + 1;
+    }
+  }
+};
+
+template<class T>
+struct OpenHashIdentity {
+  const T &operator()(const T &t) const {
+    return t;
+  }
+};
+
+template<class T>
+struct OpenHashFirst {
+  const typename T::first_type &operator()(const T &t) const {
+    return t.first;
+  }
+};
+
+/**
+ * Set of values based on OpenHashTable.
+ */
+template<class T, class Hash>
+class OpenHashSet:
+  public OpenHashTable<T, T, OpenHashIdentity<T>, Hash>
+{
+public:
+  OpenHashSet(unsigned reserve_default = 0)
+    :OpenHashTable<T, T, OpenHashIdentity<T>, Hash>(reserve_default) {}
+};
+
+/**
+ * Map of keys to values based on OpenHashTable.  Elements are
+ * std::pair objects of key and value.
+ */
+template<class Key, class Value, class Hash>
+class OpenHashMap:
+  public OpenHashTable<std::pair<Key, Value>, Key,
+                       OpenHashFirst<std::pair<Key, Value> >, Hash>
+{
+public:
+  OpenHashMap(unsigned reserve_default = 0)
+    :OpenHashTable<std::pair<Key, Value>, Key,
+                   OpenHashFirst<std::pair<Key, Value> >,
+                   Hash>(reserve_default) {}
+};
+
+/**
+ * Mix the bits of an integer so that nearby values are spread over the
+ * whole range (finaliser of MurmurHash3).
+ */
+gcc_const
+static inline unsigned
+open_hash_mix(unsigned h)
+{
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+#endif
@@ -163,6 +163,10 @@ Waypoints::append(const Waypoint &_wp)
 
   name_tree.Add(new_wp);
 
+  if (new_wp.id >= id_index.size())
+    id_index.resize(new_wp.id + 1, NULL);
+  id_index[new_wp.id] = const_cast<Waypoint *>(&new_wp);
+
   return new_wp;
 }
 
@@ -251,29 +255,13 @@ Waypoints::set_home(const unsigned id)
 {
   m_home = NULL;
 
-  for (WaypointTree::iterator found = waypoint_tree.begin();
-       found != waypoint_tree.end(); ++found) {
-    Waypoint &wp = *found;
-
-    if (wp.id == id) {
-      m_home = &wp;
-      wp.Flags.Home = true;
-      return true;
-    }
-  }
-
-  return false;
-}
+  if (id >= id_index.size() || id_index[id] == NULL)
+    return false;
 
-const Waypoint*
-Waypoints::lookup_id(const unsigned id) const
-{
-  for (const_iterator found = waypoint_tree.begin();
-       found != waypoint_tree.end(); ++found)
-    if (found->id == id)
-      return &*found;
-
-  return NULL;
+  Waypoint &wp = *id_index[id];
+  m_home = &wp;
+  wp.Flags.Home = true;
+  return true;
 }
 
 void
@@ -309,6 +297,7 @@ Waypoints::clear()
   m_home = NULL;
   name_tree.clear();
   waypoint_tree.clear();
+  id_index.clear();
   next_id = 1;
 }
 
@@ -321,6 +310,9 @@ Waypoints::erase(const Waypoint& wp)
   WaypointTree::const_iterator it = waypoint_tree.FindPointer(&wp);
   assert(it != waypoint_tree.end());
 
+  assert(wp.id < id_index.size() && id_index[wp.id] == &wp);
+  id_index[wp.id] = NULL;
+
   name_tree.Remove(wp);
   waypoint_tree.erase(it);
 }
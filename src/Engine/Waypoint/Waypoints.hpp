@@ -30,6 +30,8 @@
 
 #include "Navigation/TaskProjection.hpp"
 
+#include <vector>
+
 class WaypointVisitor;
 
 /**
@@ -72,6 +74,15 @@ class Waypoints: private NonCopyable
 
   WaypointTree waypoint_tree;
   WaypointNameTree name_tree;
+
+  /**
+   * Maps waypoint ids to the waypoint objects in #waypoint_tree.
+   * Ids are allocated sequentially, so this is a dense array; the
+   * entries of erased waypoints are NULL.  The QuadTree does not
+   * move its elements, so the pointers remain valid until the
+   * waypoint is erased.
+   */
+  std::vector<Waypoint *> id_index;
   TaskProjection task_projection;
 
   const Waypoint *m_home;
@@ -200,13 +211,16 @@ public:
   bool set_home(const unsigned id);
 
   /**
-   * Look up waypoint by ID.
+   * Look up waypoint by ID.  This is a constant time operation.
    *
    * @param id Id of waypoint to find in internal tree
    *
    * @return Pointer to waypoint if found (or NULL if not)
    */
-  const Waypoint* lookup_id(const unsigned id) const;
+  gcc_pure
+  const Waypoint* lookup_id(const unsigned id) const {
+    return id < id_index.size() ? id_index[id] : NULL;
+  }
 
   /**
    * Look up closest waypoint by location within range
@@ -35,6 +35,7 @@ Copyright_License {
 #include "Logger/Logger.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "LocalTime.hpp"
+#include "CalculationProfiler.hpp"
 
 static PeriodClock last_team_code_update;
 
@@ -88,6 +89,8 @@ GlideComputer::ProcessGPS()
   PeriodClock clock;
   clock.update();
 
+  ScopeStageTimer stage_timer(calculation_profiler, CALC_GPS);
+
   const MoreData &basic = Basic();
   DERIVED_INFO &calculated = SetCalculated();
 
@@ -96,11 +99,17 @@ GlideComputer::ProcessGPS()
   calculated.Expire(basic.clock);
 
   // Process basic information
-  ProcessBasic();
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_BASIC);
+    ProcessBasic();
+  }
 
   // Process basic task information
-  ProcessBasicTask();
-  ProcessMoreTask();
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_TASK);
+    ProcessBasicTask();
+    ProcessMoreTask();
+  }
 
   // Check if everything is okay with the gps time and process it
   if (!FlightTimes()) {
@@ -108,25 +117,37 @@ GlideComputer::ProcessGPS()
   }
 
   // Process extended information
-  ProcessVertical();
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_VERTICAL);
+    ProcessVertical();
+  }
 
-  GlideComputerStats::ProcessClimbEvents();
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_CLIMB_STATS);
+    GlideComputerStats::ProcessClimbEvents();
+  }
+
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_TEAM_TRAFFIC);
 
-  // Calculate the team code
-  CalculateOwnTeamCode();
+    // Calculate the team code
+    CalculateOwnTeamCode();
 
-  // Calculate the bearing and range of the teammate
-  CalculateTeammateBearingRange();
+    // Calculate the bearing and range of the teammate
+    CalculateTeammateBearingRange();
 
-  // Calculate the bearing and range of the teammate
-  // (if teammate is a FLARM target)
-  FLARM_ScanTraffic();
+    // Calculate the bearing and range of the teammate
+    // (if teammate is a FLARM target)
+    FLARM_ScanTraffic();
+  }
 
   vegavoice.Update(basic, Calculated(), SettingsComputer());
 
   // update basic trace history
-  if (time_advanced())
+  if (time_advanced()) {
+    ScopeStageTimer timer(calculation_profiler, CALC_TRACE);
     calculated.trace_history.append(basic);
+  }
 
   // Update the ConditionMonitors
   ConditionMonitorsUpdate(*this);
@@ -148,12 +169,24 @@ GlideComputer::ProcessIdle()
   PeriodClock clock;
   clock.update();
 
+  ScopeStageTimer stage_timer(calculation_profiler, CALC_IDLE);
+
   // Log GPS fixes for internal usage
   // (snail trail, stats, olc, ...)
-  DoLogging();
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_LOGGING);
+    DoLogging();
+  }
 
-  GlideComputerAirData::ProcessIdle();
-  GlideComputerTask::ProcessIdle();
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_AIRSPACE_WARNING);
+    GlideComputerAirData::ProcessIdle();
+  }
+
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_TASK_IDLE);
+    GlideComputerTask::ProcessIdle();
+  }
   SetCalculated().time_process_idle = clock.elapsed();
 }
 
@@ -38,6 +38,7 @@ Copyright_License {
 #include "NMEA/Aircraft.hpp"
 #include "AutoQNH.hpp"
 #include "Math/SunEphemeris.hpp"
+#include "CalculationProfiler.hpp"
 
 #include <algorithm>
 
@@ -86,7 +87,11 @@ GlideComputerAirData::ResetFlight(const bool full)
 void
 GlideComputerAirData::ProcessBasic()
 {
-  TerrainHeight();
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_TERRAIN);
+    TerrainHeight();
+  }
+
   ProcessSun();
 
   NettoVario();
@@ -107,13 +112,19 @@ GlideComputerAirData::ProcessVertical()
   TurnRate();
   Turning();
 
-  Wind();
-  SelectWind();
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_WIND);
+    Wind();
+    SelectWind();
+  }
 
-  thermallocator.Process(calculated.Circling,
-                         basic.Time, basic.Location,
-                         basic.NettoVario,
-                         calculated.wind, calculated.thermal_locator);
+  {
+    ScopeStageTimer timer(calculation_profiler, CALC_THERMAL_LOCATOR);
+    thermallocator.Process(calculated.Circling,
+                           basic.Time, basic.Location,
+                           basic.NettoVario,
+                           calculated.wind, calculated.thermal_locator);
+  }
 
   CuSonde::updateMeasurements(basic, calculated);
   LastThermalStats();
@@ -380,7 +391,7 @@ GlideComputerAirData::UpdateLiftDatabase()
       h_av += calculated.LiftDatabase[i];
     }
     h_av/= 36;
-    calculated.trace_history.CirclingAverage.push(h_av);
+    calculated.trace_history.append_circling_average(h_av);
   }
 }
 
@@ -391,7 +402,7 @@ GlideComputerAirData::ResetLiftDatabase()
 
   calculated.ClearLiftDatabase();
 
-  calculated.trace_history.CirclingAverage.clear();
+  calculated.trace_history.clear_circling_average();
 }
 
 void
@@ -52,7 +52,7 @@ Copyright_License {
 //   Nav: e_WP_Distance,e_WP_AltDiff,e_WP_H,e_WP_AltReq,e_Fin_AltDiff,e_Fin_AltReq,e_SpeedTaskAvg,59,61,e_Fin_Distance,e_AA_Time,e_AA_DistanceMax,e_AA_DistanceMin,e_AA_SpeedMax,e_AA_SpeedMin,e_Fin_AA_Distance,e_AA_SpeedAvg,60,73
 //   Waypoint: e_WP_Name,e_TimeSinceTakeoff,e_TimeLocal,e_TimeUTC,e_Fin_Time,e_WP_Time,e_Fin_TimeLocal,e_WP_TimeLocal,e_RH_Trend
 //   Team: e_Team_Code,e_Team_Bearing,e_Team_BearingDiff,e_Team_Range
-//   Gadget: e_Battery,e_CPU_Load
+//   Gadget: e_Battery,e_CPU_Load,e_Calc_Time
 //   Alternates: e_Alternate_1_Name,e_Alternate_2_Name,e_Alternate_1_GR
 //   Experimental: e_Experimental1,e_Experimental2
 const InfoBoxFactory::InfoBoxMetaData InfoBoxFactory::MetaData[NUM_TYPES] = {
@@ -651,7 +651,7 @@ const InfoBoxFactory::InfoBoxMetaData InfoBoxFactory::MetaData[NUM_TYPES] = {
     N_("Battery"),
     N_("Displays percentage of device battery remaining (where applicable) and status/voltage of external power supply."),
     e_CPU_Load, // CPU
-    e_CPU_Load, // CPU
+    e_Calc_Time, // Calc time
   },
 
   // 66
@@ -740,7 +740,7 @@ const InfoBoxFactory::InfoBoxMetaData InfoBoxFactory::MetaData[NUM_TYPES] = {
     N_("CPU load"),
     N_("CPU"),
     N_("CPU load consumed by XCSoar averaged over 5 seconds."),
-    e_Battery, // Battery
+    e_Calc_Time, // Calc time
     e_Battery, // Battery
   },
 
@@ -857,6 +857,14 @@ const InfoBoxFactory::InfoBoxMetaData InfoBoxFactory::MetaData[NUM_TYPES] = {
     e_Fin_TimeLocal, // Fin ETA
     e_Fin_Time, // Fin ETE
   },
+
+  {
+    N_("Calculation time"),
+    N_("Calc time"),
+    N_("95th percentile of the time in milliseconds the calculation thread needs to process one update; the comment shows the median and the maximum. Press enter to start or stop profiling, down to reset the statistics."),
+    e_Battery, // Battery
+    e_CPU_Load, // CPU
+  },
 };
 
 InfoBoxContent*
@@ -1041,6 +1049,8 @@ InfoBoxFactory::Create(unsigned InfoBoxType)
     return new InfoBoxContentNextETEVMG();
   case e_Horizon:
     return new InfoBoxContentHorizon();
+  case e_Calc_Time:
+    return new InfoBoxContentCalculationTime();
   }
 
   return NULL;
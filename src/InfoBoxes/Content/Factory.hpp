@@ -132,6 +132,7 @@ namespace InfoBoxFactory
     e_Fin_ETE_VMG,
     e_WP_ETE_VMG,
     e_Horizon,
+    e_Calc_Time, /* Duration of the calculation thread tick */
     e_NUM_TYPES /* Last item */
   };
 
@@ -30,6 +30,7 @@ Copyright_License {
 #include "OS/SystemLoad.hpp"
 #include "OS/MemInfo.hpp"
 #include "Asset.hpp"
+#include "CalculationProfiler.hpp"
 
 #include <tchar.h>
 #include <stdio.h>
@@ -140,6 +141,49 @@ InfoBoxContentCPULoad::Update(InfoBoxWindow &infobox)
   }
 }
 
+void
+InfoBoxContentCalculationTime::Update(InfoBoxWindow &infobox)
+{
+  if (!calculation_profiler.IsEnabled()) {
+    infobox.SetValueInvalid();
+    infobox.SetComment(_T("off"));
+    return;
+  }
+
+  const TimingHistogram tick = calculation_profiler.Get(CALC_TICK);
+  if (tick.GetCount() == 0) {
+    infobox.SetInvalid();
+    return;
+  }
+
+  // Set Value: 95th percentile of the tick duration
+  TCHAR tmp[32];
+  _stprintf(tmp, _T("%.1f"), tick.GetPercentile(95) / 1000.);
+  infobox.SetValue(tmp);
+
+  // Set Comment: median and worst case
+  _stprintf(tmp, _T("%.1f/%.1f"),
+            tick.GetPercentile(50) / 1000., tick.GetMax() / 1000.);
+  infobox.SetComment(tmp);
+}
+
+bool
+InfoBoxContentCalculationTime::HandleKey(const InfoBoxKeyCodes keycode)
+{
+  switch (keycode) {
+  case ibkEnter:
+    calculation_profiler.SetEnabled(!calculation_profiler.IsEnabled());
+    return true;
+
+  case ibkDown:
+    calculation_profiler.Reset();
+    return true;
+
+  default:
+    return false;
+  }
+}
+
 void
 InfoBoxContentFreeRAM::Update(InfoBoxWindow &infobox)
 {
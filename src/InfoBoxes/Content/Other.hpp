@@ -62,6 +62,13 @@ public:
   virtual void Update(InfoBoxWindow &infobox);
 };
 
+class InfoBoxContentCalculationTime : public InfoBoxContent
+{
+public:
+  virtual void Update(InfoBoxWindow &infobox);
+  virtual bool HandleKey(const InfoBoxKeyCodes keycode);
+};
+
 class InfoBoxContentHorizon : public InfoBoxContent
 {
 public:
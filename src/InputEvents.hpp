@@ -148,6 +148,8 @@ namespace InputEvents
   void eventFlarmDetails(const TCHAR *misc);
   void eventCredits(const TCHAR *misc);
   void eventWeather(const TCHAR *misc);
+  void eventProfiler(const TCHAR *misc);
+  void eventMapProfiler(const TCHAR *misc);
   // -------
 };
 
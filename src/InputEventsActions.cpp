@@ -78,6 +78,7 @@ doc/html/advanced/input/ALL		http://xcsoar.sourceforge.net/advanced/input/
 #include "LocalPath.hpp"
 #include "Profile/ProfileKeys.hpp"
 #include "UtilsText.hpp"
+#include "CalculationProfiler.hpp"
 #include "StringUtil.hpp"
 #include "Audio/Sound.hpp"
 #include "Interface.hpp"
@@ -1172,7 +1173,7 @@ InputEvents::eventLogger(const TCHAR *misc)
     logger.guiToggleLogger(basic, settings_computer,
                            *protected_task_manager, true);
   else if (_tcscmp(misc, _T("nmea")) == 0) {
-    EnableLogNMEA = !EnableLogNMEA;
+    RawLoggerEnable(!EnableLogNMEA);
     if (EnableLogNMEA) {
       Message::AddMessage(_("NMEA log on"));
     } else {
@@ -1874,3 +1875,83 @@ InputEvents::eventWeather(const TCHAR *misc)
   if (_tcscmp(misc, _T("list")) == 0)
     dlgNOAAListShowModal(XCSoarInterface::main_window);
 }
+
+// Profiler
+// Controls the timing of the calculation thread stages
+//  on: starts collecting timings
+//  off: stops collecting timings
+//  toggle: toggles collecting timings
+//  reset: discards all collected timings
+//  dump: writes the collected timings to the log file
+void
+InputEvents::eventProfiler(const TCHAR *misc)
+{
+  if (_tcscmp(misc, _T("on")) == 0)
+    calculation_profiler.SetEnabled(true);
+  else if (_tcscmp(misc, _T("off")) == 0)
+    calculation_profiler.SetEnabled(false);
+  else if (_tcscmp(misc, _T("toggle")) == 0)
+    calculation_profiler.SetEnabled(!calculation_profiler.IsEnabled());
+  else if (_tcscmp(misc, _T("reset")) == 0)
+    calculation_profiler.Reset();
+  else if (_tcscmp(misc, _T("dump")) == 0) {
+    calculation_profiler.Dump();
+    Message::AddMessage(_("Profile written to log file"));
+    return;
+  }
+
+  if (calculation_profiler.IsEnabled())
+    Message::AddMessage(_("Profiler on"));
+  else
+    Message::AddMessage(_("Profiler off"));
+}
+
+// MapProfiler
+// Controls the timing of the map layers
+//  on: starts recording frames
+//  off: stops recording frames
+//  toggle: toggles recording frames
+//  overlay: toggles the summary on the map
+//  csv: toggles writing every frame to map-profile.csv
+//  reset: discards all recorded frames
+void
+InputEvents::eventMapProfiler(const TCHAR *misc)
+{
+  GlueMapWindow *map_window = CommonInterface::main_window.map;
+  if (map_window == NULL)
+    return;
+
+  MapRenderProfiler &profiler = map_window->GetRenderProfiler();
+
+  if (_tcscmp(misc, _T("on")) == 0)
+    profiler.SetEnabled(true);
+  else if (_tcscmp(misc, _T("off")) == 0)
+    profiler.SetEnabled(false);
+  else if (_tcscmp(misc, _T("toggle")) == 0)
+    profiler.SetEnabled(!profiler.IsEnabled());
+  else if (_tcscmp(misc, _T("overlay")) == 0)
+    profiler.SetOverlayEnabled(!profiler.IsOverlayEnabled());
+  else if (_tcscmp(misc, _T("reset")) == 0)
+    profiler.Reset();
+  else if (_tcscmp(misc, _T("csv")) == 0) {
+    if (profiler.IsCSVOpen()) {
+      profiler.CloseCSV();
+      Message::AddMessage(_("Map profile closed"));
+    } else {
+      TCHAR path[MAX_PATH];
+      LocalPath(path, _T("map-profile.csv"));
+      if (profiler.OpenCSV(path)) {
+        profiler.SetEnabled(true);
+        Message::AddMessage(_("Map profile"), path);
+      } else
+        Message::AddMessage(_("Failed to create file"), path);
+    }
+
+    return;
+  }
+
+  if (profiler.IsEnabled())
+    Message::AddMessage(_("Map profiler on"));
+  else
+    Message::AddMessage(_("Map profiler off"));
+}
@@ -64,7 +64,9 @@ igc_format_location(char *buffer, const GeoPoint &location)
 }
 
 IGCWriter::IGCWriter(const TCHAR *_path, const NMEA_INFO &gps_info)
-  :Simulator(gps_info.Connected && !gps_info.gps.real)
+  :file(NULL), wake(false), drained(false),
+   queued(0), written(0), failed(false), stopping(false),
+   Simulator(gps_info.Connected && !gps_info.gps.real)
 {
   _tcscpy(path, _path);
 
@@ -73,30 +75,83 @@ IGCWriter::IGCWriter(const TCHAR *_path, const NMEA_INFO &gps_info)
 
   if (!Simulator)
     grecord.Init();
+
+  file = new TextWriter(path, true);
+  if (file->error()) {
+    failed = true;
+    return;
+  }
+
+  /* if the thread cannot be started, writeln() falls back to writing
+     synchronously */
+  Start();
 }
 
-bool
-IGCWriter::flush()
+IGCWriter::~IGCWriter()
 {
-  if (buffer.empty())
-    return true;
+  StopThread();
+  delete file;
+}
 
-  TextWriter writer(path, true);
-  if (writer.error())
-    return false;
+void
+IGCWriter::StopThread()
+{
+  if (!IsDefined())
+    return;
 
-  for (unsigned i = 0; i < buffer.length(); ++i) {
-    if (!writer.writeln(buffer[i]))
-      return false;
+  stopping = true;
+  wake.Signal();
+  Join();
+}
 
-    grecord.AppendRecordToBuffer(buffer[i]);
+void
+IGCWriter::Drain()
+{
+  unsigned n = 0;
+
+  const Record *record;
+  while ((record = queue.read()) != NULL) {
+    if (!failed) {
+      if (file->writeln(record->line))
+        grecord.AppendRecordToBuffer(record->line);
+      else
+        failed = true;
+    }
+
+    queue.consume();
+    ++n;
   }
 
-  if (!writer.flush())
-    return false;
+  if (n > 0 && !failed && !file->flush())
+    failed = true;
 
-  buffer.clear();
-  return true;
+  written += n;
+}
+
+void
+IGCWriter::Run()
+{
+  while (true) {
+    wake.Wait();
+
+    const bool stop = stopping;
+    Drain();
+    drained.Signal();
+
+    if (stop)
+      break;
+  }
+}
+
+bool
+IGCWriter::flush()
+{
+  while (IsDefined() && written != queued) {
+    wake.Signal();
+    drained.Wait();
+  }
+
+  return !failed;
 }
 
 void
@@ -105,7 +160,10 @@ IGCWriter::finish(const NMEA_INFO &gps_info)
   if (gps_info.Connected && !gps_info.gps.real)
     Simulator = true;
 
-  flush();
+  StopThread();
+
+  delete file;
+  file = NULL;
 }
 
 static void
@@ -119,17 +177,32 @@ clean(char *p)
 bool
 IGCWriter::writeln(const char *line)
 {
-  if (buffer.full() && !flush())
+  if (file == NULL || failed)
     return false;
 
-  assert(!buffer.full());
+  Record *record;
+  while ((record = queue.write()) == NULL) {
+    /* the thread is behind, wait until it has made room */
+    assert(IsDefined());
 
-  char *dest = buffer.append();
+    wake.Signal();
+    drained.Wait();
+  }
+
+  char *dest = record->line;
   strncpy(dest, line, MAX_IGC_BUFF);
   dest[MAX_IGC_BUFF - 1] = '\0';
 
   clean(dest);
 
+  queue.append();
+  ++queued;
+
+  if (IsDefined())
+    wake.Signal();
+  else
+    Drain();
+
   return true;
 }
 
@@ -381,6 +454,9 @@ IGCWriter::sign()
   if (Simulator)
     return;
 
+  /* the thread must not touch the digest while we finalize it */
+  StopThread();
+
   // buffer is appended w/ each igc file write
   grecord.FinalizeBuffer();
   // read record built by individual file writes
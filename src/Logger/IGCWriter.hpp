@@ -26,7 +26,9 @@ Copyright_License {
 
 #include "Logger/LoggerFRecord.hpp"
 #include "Logger/LoggerGRecord.hpp"
-#include "BatchBuffer.hpp"
+#include "Thread/Thread.hpp"
+#include "Thread/Trigger.hpp"
+#include "Thread/LockFreeFifo.hpp"
 #include "Math/fixed.hpp"
 #include "Engine/Navigation/GeoPoint.hpp"
 
@@ -37,17 +39,60 @@ struct BrokenDateTime;
 struct NMEA_INFO;
 struct Declaration;
 struct GeoPoint;
-
-class IGCWriter {
+class TextWriter;
+
+/**
+ * Formats IGC records and hands them to a private thread, which
+ * appends them to the file and feeds them to the G record digest.
+ * This keeps disk latency and MD5 work away from the caller, usually
+ * the calculation thread.
+ *
+ * The public methods must be called from only one thread at a time
+ * (the Logger serialises them with its write lock).
+ */
+class IGCWriter : private Thread {
   enum {
-    LOGGER_DISK_BUFFER_NUM_RECS = 10, /**< Number of records in disk buffer */
+    QUEUE_SIZE = 64, /**< Number of records waiting for the write thread */
     MAX_IGC_BUFF = 255,
   };
 
+  struct Record {
+    char line[MAX_IGC_BUFF];
+  };
+
   TCHAR path[MAX_PATH];
-  BatchBuffer<char[MAX_IGC_BUFF],LOGGER_DISK_BUFFER_NUM_RECS> buffer;
+
+  /**
+   * The IGC file, kept open in append mode.  While the thread runs,
+   * it is accessed only by the thread.
+   */
+  TextWriter *file;
+
+  LockFreeFifo<Record, QUEUE_SIZE> queue;
+
+  /** Wakes up the thread after records have been queued */
+  ::Trigger wake;
+
+  /** Signalled by the thread after it has written a batch */
+  ::Trigger drained;
+
+  /** The number of records passed to the queue */
+  unsigned queued;
+
+  /** The number of records written and flushed by the thread */
+  volatile unsigned written;
+
+  /** Set when writing to the file has failed */
+  volatile bool failed;
+
+  volatile bool stopping;
 
   LoggerFRecord frecord;
+
+  /**
+   * The digest of all records written so far.  While the thread
+   * runs, it is accessed only by the thread.
+   */
   GRecord grecord;
 
   /**
@@ -70,13 +115,33 @@ class IGCWriter {
 
 public:
   IGCWriter(const TCHAR *_path, const NMEA_INFO &gps_info);
+  ~IGCWriter();
 
+  /**
+   * Waits until the thread has written all queued records.
+   */
   bool flush();
+
+  /**
+   * Writes all queued records, stops the thread and closes the file.
+   */
   void finish(const NMEA_INFO &gps_info);
   void sign();
 
   bool writeln(const char *line);
 
+private:
+  void StopThread();
+
+  /**
+   * Writes and digests all queued records.  Called by the thread, or
+   * by the caller if the thread could not be started.
+   */
+  void Drain();
+
+protected:
+  virtual void Run();
+
 private:
   bool write_tstring(const char *a, const TCHAR *b);
 
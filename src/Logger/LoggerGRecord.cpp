@@ -60,24 +60,20 @@ GRecord::AppendRecordToBuffer(const char *record)
 void
 GRecord::AppendStringToBuffer(const unsigned char * szIn)
 {
-  for (int i = 0; i < 4; i++) {
-    oMD5[i].AppendString(szIn, 1); // skip whitespace flag=1
-  }
+  oMD5.AppendString(szIn, 1); // skip whitespace flag=1
 }
 
 void
 GRecord::FinalizeBuffer()
 {
-  for (int i = 0; i < 4; i++) {
-    oMD5[i].Finalize();
-  }
+  oMD5.Finalize();
 }
 
 void
 GRecord::GetDigest(char *szOutput)
 {
   for (int idig=0; idig <=3; idig++) {
-    oMD5[idig].GetDigest(szOutput + idig * 32);
+    oMD5.GetDigest(idig, szOutput + idig * 32);
   }
 
   szOutput[128]='\0';
@@ -93,44 +89,42 @@ GRecord::Init(int iKey)
     FileName[i]=0;
   }
 
-  for (i=0; i < 3; i++) {
-    oMD5[i].InitDigest();
-  }
+  oMD5.InitDigest();
 
   switch ( iKey) // 4 different 512 bit keys
   {
   case 1: // key 1
-    oMD5[0].InitKey(0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476);
-    oMD5[1].InitKey(0x48327203, 0x3948ebea, 0x9a9b9c9e, 0xb3bed89a);
+    oMD5.InitKey(0, 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476);
+    oMD5.InitKey(1, 0x48327203, 0x3948ebea, 0x9a9b9c9e, 0xb3bed89a);
 
-    oMD5[2].InitKey(0x67452301, 0xefcdab89,  0x98badcfe, 0x10325476);
-    oMD5[3].InitKey( 0xc8e899e8, 0x9321c28a, 0x438eba12, 0x8cbe0aee);
+    oMD5.InitKey(2, 0x67452301, 0xefcdab89,  0x98badcfe, 0x10325476);
+    oMD5.InitKey(3, 0xc8e899e8, 0x9321c28a, 0x438eba12, 0x8cbe0aee);
     break;
 
   case 2: // key 2
 
-    oMD5[0].InitKey(0x1C80A301,0x9EB30b89,0x39CB2Afe,0x0D0FEA76);
-    oMD5[1].InitKey(0x48327203,0x3948ebea,0x9a9b9c9e,0xb3bed89a);
+    oMD5.InitKey(0, 0x1C80A301,0x9EB30b89,0x39CB2Afe,0x0D0FEA76);
+    oMD5.InitKey(1, 0x48327203,0x3948ebea,0x9a9b9c9e,0xb3bed89a);
 
-    oMD5[2].InitKey(0x67452301,0xefcdab89,0x98badcfe,0x10325476);
-    oMD5[3].InitKey(0xc8e899e8,0x9321c28a,0x438eba12,0x8cbe0aee);
+    oMD5.InitKey(2, 0x67452301,0xefcdab89,0x98badcfe,0x10325476);
+    oMD5.InitKey(3, 0xc8e899e8,0x9321c28a,0x438eba12,0x8cbe0aee);
     break;
 
   case 3: // key 3
 
-    oMD5[0].InitKey(0x7894abde,0x9cb4e90a,0x0bc8f0ea,0x03a9e01a);
-    oMD5[1].InitKey(0x3c4a4c93,0x9cbf7ae3,0xa9bcd0ea,0x9a8c2aaa);
+    oMD5.InitKey(0, 0x7894abde,0x9cb4e90a,0x0bc8f0ea,0x03a9e01a);
+    oMD5.InitKey(1, 0x3c4a4c93,0x9cbf7ae3,0xa9bcd0ea,0x9a8c2aaa);
 
-    oMD5[2].InitKey(0x3c9ae1f1,0x9fe02a1f,0x3fc9a497,0x93cad3ef);
-    oMD5[3].InitKey(0x41a0c8e8,0xf0e37acf,0xd8bcabe2,0x9bed015a);
+    oMD5.InitKey(2, 0x3c9ae1f1,0x9fe02a1f,0x3fc9a497,0x93cad3ef);
+    oMD5.InitKey(3, 0x41a0c8e8,0xf0e37acf,0xd8bcabe2,0x9bed015a);
     break;
 
   default:  // key 1
-    oMD5[0].InitKey(0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476);
-    oMD5[1].InitKey(0x48327203, 0x3948ebea, 0x9a9b9c9e, 0xb3bed89a);
+    oMD5.InitKey(0, 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476);
+    oMD5.InitKey(1, 0x48327203, 0x3948ebea, 0x9a9b9c9e, 0xb3bed89a);
 
-    oMD5[2].InitKey(0x67452301, 0xefcdab89,  0x98badcfe, 0x10325476);
-    oMD5[3].InitKey( 0xc8e899e8, 0x9321c28a, 0x438eba12, 0x8cbe0aee);
+    oMD5.InitKey(2, 0x67452301, 0xefcdab89,  0x98badcfe, 0x10325476);
+    oMD5.InitKey(3, 0xc8e899e8, 0x9321c28a, 0x438eba12, 0x8cbe0aee);
     break;
 
   }
@@ -37,7 +37,7 @@ public:
   };
 
 private:
-  MD5 oMD5[4];
+  MD5 oMD5;
 
   enum {
     BUFF_LEN = 255,
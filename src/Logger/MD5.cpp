@@ -22,6 +22,7 @@
 
 #include "Logger/MD5.hpp"
 
+#include <assert.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -107,14 +108,31 @@ leftrotate(uint32_t x, uint32_t c)
     return (x << c) | (x >> (32-c));
 }
 
+/**
+ * One MD5 step: mixes the round function value "f" and the message
+ * word "w" into the state and rotates the state words.
+ */
+static inline void
+md5_step(uint32_t &a, uint32_t &b, uint32_t &c, uint32_t &d,
+         uint32_t f, unsigned i, uint32_t w)
+{
+  const uint32_t temp = d;
+  d = c;
+  c = b;
+  b = b + leftrotate(a + f + k[i] + w, r[i]);
+  a = temp;
+}
+
 void
-MD5::InitKey(uint32_t h0in, uint32_t h1in, uint32_t h2in, uint32_t h3in)
+MD5::InitKey(unsigned lane,
+             uint32_t h0in, uint32_t h1in, uint32_t h2in, uint32_t h3in)
 {
-  h0=h0in;
-  h1=h1in;
-  h2=h2in;
-  h3=h3in;
-  MessageLenBits=0;
+  assert(lane < LANES);
+
+  h0[lane]=h0in;
+  h1[lane]=h1in;
+  h2[lane]=h2in;
+  h3[lane]=h3in;
 }
 void
 MD5::InitDigest(void)
@@ -122,11 +140,10 @@ MD5::InitDigest(void)
   memset(buff512bits,0,64);
 
   MessageLenBits=0;
-  a=0; b=0; c=0; d=0;
-  h0=0; h1=0; h2=0; h3=0;
-  f=0; g=0;
-
-
+  memset(h0, 0, sizeof(h0));
+  memset(h1, 0, sizeof(h1));
+  memset(h2, 0, sizeof(h2));
+  memset(h3, 0, sizeof(h3));
 }
 
 /*
@@ -237,12 +254,6 @@ void
 MD5::Process512(const unsigned char *s512in)
 { // assume exactly 512 bytes
 
-//Initialize hash value for this chunk:
-  a=h0;
-  b=h1;
-  c=h2;
-  d=h3;
-
   // copy the 64 chars into the 16 uint32_ts
   uint32_t w[16];
   for (int j=0; j < 16; j++) {
@@ -251,45 +262,56 @@ MD5::Process512(const unsigned char *s512in)
           (((uint32_t)s512in[(j*4)+1]) << 8) |
           ((uint32_t)s512in[(j*4)]);
   }
-//Main loop:
-  for (int i=0; i < 64; i++) {
-    if (i <= 15) {
-      f = (b & c) | ((~b) & d);
-      g = i;
-    }
-    else if (i <= 31) {
-      f = (d & b) | ((~d) & c);
-      g = (5*i + 1) % 16;
-    }
-    else if (i <= 47) {
-      f = b ^ c ^ d;
-      g = (3 * i + 5) % 16;
-    }
-    else {
-      f = c ^ (b | (~d));
-      g = (7 * i) % 16;
-    }
 
-    uint32_t temp = d;
-    d = c;
-    c = b;
-    b = b + leftrotate((a + f + k[i] + w[g]) , r[i]);
-    a = temp;
+//Initialize hash value for this chunk:
+  uint32_t a[LANES], b[LANES], c[LANES], d[LANES];
+  for (unsigned l = 0; l < LANES; l++) {
+    a[l] = h0[l];
+    b[l] = h1[l];
+    c[l] = h2[l];
+    d[l] = h3[l];
   }
 
+//Main loop, one round function per group of 16 steps:
+  for (unsigned i = 0; i < 16; i++)
+    for (unsigned l = 0; l < LANES; l++)
+      md5_step(a[l], b[l], c[l], d[l],
+               (b[l] & c[l]) | ((~b[l]) & d[l]), i, w[i]);
+
+  for (unsigned i = 16; i < 32; i++)
+    for (unsigned l = 0; l < LANES; l++)
+      md5_step(a[l], b[l], c[l], d[l],
+               (d[l] & b[l]) | ((~d[l]) & c[l]), i, w[(5 * i + 1) % 16]);
+
+  for (unsigned i = 32; i < 48; i++)
+    for (unsigned l = 0; l < LANES; l++)
+      md5_step(a[l], b[l], c[l], d[l],
+               b[l] ^ c[l] ^ d[l], i, w[(3 * i + 5) % 16]);
+
+  for (unsigned i = 48; i < 64; i++)
+    for (unsigned l = 0; l < LANES; l++)
+      md5_step(a[l], b[l], c[l], d[l],
+               c[l] ^ (b[l] | (~d[l])), i, w[(7 * i) % 16]);
 
   //Add this chunk's hash to result so far:
-  h0 = h0 + a;
-  h1 = h1 + b;
-  h2 = h2 + c;
-  h3 = h3 + d;
+  for (unsigned l = 0; l < LANES; l++) {
+    h0[l] = h0[l] + a[l];
+    h1[l] = h1[l] + b[l];
+    h2[l] = h2[l] + c[l];
+    h3[l] = h3[l] + d[l];
+  }
 }
 
 
 
 int
-MD5::GetDigest(char *buffer)
+MD5::GetDigest(unsigned lane, char *buffer) const
 { // extract 4 bytes from each uint32_t
+  assert(lane < LANES);
+
+  const uint32_t h0 = this->h0[lane], h1 = this->h1[lane];
+  const uint32_t h2 = this->h2[lane], h3 = this->h3[lane];
+
   unsigned char digest[16];
 
   digest[0] = (unsigned char) (h0 & 0xFF);
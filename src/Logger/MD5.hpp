@@ -25,30 +25,37 @@
 
 #include <stdint.h>
 
+/**
+ * Computes several MD5 digests of the same message at once, each
+ * started from a different key (initial state).  The message is
+ * filtered and buffered only once, and the 64 steps of each block
+ * advance all lanes side by side, which lets the CPU overlap their
+ * independent dependency chains.
+ */
 class MD5
 {
 public:
   enum {
     DIGEST_LENGTH = 16,
+    LANES = 4,
   };
 
 private:
   unsigned char buff512bits[64];
-  uint32_t a, b, c, d;
-  uint32_t h0, h1, h2, h3;
-  uint32_t f, g;
+  uint32_t h0[LANES], h1[LANES], h2[LANES], h3[LANES];
   uint32_t MessageLenBits; // max message size=536,870,912 because of 32-bit length tracking (MD5 standard is 64-bits)
 
   void Process512(const unsigned char * s512in);
 
 public:
 
-  void InitKey(uint32_t h0in, uint32_t h1in, uint32_t h2in, uint32_t h3in);
+  void InitKey(unsigned lane,
+               uint32_t h0in, uint32_t h1in, uint32_t h2in, uint32_t h3in);
 
   void InitDigest(void);
   void AppendString(const unsigned char *sin, int bSkipWhiteSpaceFlag); // must be NULL-terminated string!
   void Finalize(void);
-  int GetDigest(char *buffer);
+  int GetDigest(unsigned lane, char *buffer) const;
     //int IsWhiteSpace(char c);
   static bool IsValidIGCChar(char c);
 
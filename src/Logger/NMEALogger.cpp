@@ -22,27 +22,100 @@ Copyright_License {
 */
 
 #include "Logger/NMEALogger.hpp"
-#include "IO/BatchTextWriter.hpp"
+#include "IO/TextWriter.hpp"
 #include "LocalPath.hpp"
+#include "LogFile.hpp"
 #include "NMEA/Info.hpp"
 #include "Thread/Mutex.hpp"
+#include "Thread/WorkerThread.hpp"
+#include "Util/FifoBuffer.hpp"
 #include "Interface.hpp"
 #include "OS/FileUtil.hpp"
 
 #include <windef.h> // for MAX_PATH
 #include <stdio.h>
-
+#include <string.h>
+
+/**
+ * Writes the contents of RawLoggerBuffer to the file, at most once per
+ * second.
+ */
+class RawLoggerThread : public WorkerThread {
+public:
+  RawLoggerThread():WorkerThread(1000) {}
+
+protected:
+  virtual void Tick();
+};
+
+/**
+ * Holds about 20 seconds of 10 Hz NMEA input, giving the file
+ * system time to recover from a stall.
+ */
+typedef FifoBuffer<char, 16384> RawLoggerBufferType;
+
+/**
+ * Protects RawLoggerBuffer, RawLoggerOverflowCount and
+ * RawLoggerFailed
+ */
 static Mutex RawLoggerMutex;
-static BatchTextWriter *RawLoggerWriter;
+static RawLoggerBufferType RawLoggerBuffer;
+static unsigned RawLoggerOverflowCount;
+
+/**
+ * Set when the file could not be opened, so the port threads don't
+ * retry on every line.  Cleared by RawLoggerEnable() and
+ * RawLoggerShutdown().
+ */
+static bool RawLoggerFailed;
+
+/** accessed only by the RawLoggerThread while it is running */
+static TextWriter *RawLoggerWriter;
+static RawLoggerThread *RawLoggerFlusher;
 
 bool EnableLogNMEA = false;
 
+/**
+ * Moves all buffered lines to the file.  The lock is held only while
+ * copying from the buffer, not while writing.
+ */
+static void
+RawLoggerFlush()
+{
+  static char chunk[sizeof(RawLoggerBuffer)];
+  unsigned length;
+
+  {
+    ScopeLock protect(RawLoggerMutex);
+    RawLoggerBufferType::Range range = RawLoggerBuffer.read();
+    length = range.second;
+    memcpy(chunk, range.first, length);
+    RawLoggerBuffer.consume(length);
+  }
+
+  if (length > 0 && RawLoggerWriter->write(chunk, length))
+    RawLoggerWriter->flush();
+}
+
+void
+RawLoggerThread::Tick()
+{
+  RawLoggerFlush();
+}
+
+/**
+ * Opens the file and starts the writer thread.  Caller must hold
+ * RawLoggerMutex.
+ */
 static bool
 RawLoggerStart()
 {
   if (RawLoggerWriter != NULL)
     return true;
 
+  if (RawLoggerFailed)
+    return false;
+
   BrokenDateTime dt = XCSoarInterface::Basic().DateTime;
   assert(dt.Plausible());
 
@@ -58,14 +131,54 @@ RawLoggerStart()
 
   LocalPath(path, _T("logs"), name);
 
-  RawLoggerWriter = new BatchTextWriter(path, false);
-  return RawLoggerWriter != NULL;
+  TextWriter *writer = new TextWriter(path, false);
+  if (writer->error()) {
+    delete writer;
+    RawLoggerFailed = true;
+    return false;
+  }
+
+  RawLoggerWriter = writer;
+  RawLoggerFlusher = new RawLoggerThread();
+  RawLoggerFlusher->Start();
+  return true;
+}
+
+void
+RawLoggerEnable(bool enable)
+{
+  ScopeLock protect(RawLoggerMutex);
+  EnableLogNMEA = enable;
+  RawLoggerFailed = false;
 }
 
 void
 RawLoggerShutdown()
 {
-  delete RawLoggerWriter;
+  if (RawLoggerFlusher != NULL) {
+    RawLoggerFlusher->BeginStop();
+    RawLoggerFlusher->Join();
+    delete RawLoggerFlusher;
+    RawLoggerFlusher = NULL;
+  }
+
+  if (RawLoggerWriter != NULL) {
+    RawLoggerFlush();
+    delete RawLoggerWriter;
+    RawLoggerWriter = NULL;
+  }
+
+  if (RawLoggerOverflowCount > 0)
+    LogStartUp(_T("NMEA logger dropped %u lines"), RawLoggerOverflowCount);
+
+  RawLoggerFailed = false;
+}
+
+unsigned
+RawLoggerOverflows()
+{
+  ScopeLock protect(RawLoggerMutex);
+  return RawLoggerOverflowCount;
 }
 
 void
@@ -74,7 +187,27 @@ LogNMEA(const char *text)
   if (!EnableLogNMEA)
     return;
 
+#ifdef HAVE_POSIX
+  static const char newline[] = "\n";
+#else
+  static const char newline[] = "\r\n";
+#endif
+
+  const size_t length = strlen(text);
+
   ScopeLock protect(RawLoggerMutex);
-  if (RawLoggerStart())
-    RawLoggerWriter->writeln(text);
+  if (!RawLoggerStart())
+    return;
+
+  RawLoggerBufferType::Range range = RawLoggerBuffer.write();
+  if (range.second < length + sizeof(newline) - 1) {
+    ++RawLoggerOverflowCount;
+    return;
+  }
+
+  memcpy(range.first, text, length);
+  memcpy(range.first + length, newline, sizeof(newline) - 1);
+  RawLoggerBuffer.append(length + sizeof(newline) - 1);
+
+  RawLoggerFlusher->Trigger();
 }
@@ -28,11 +28,26 @@ Copyright_License {
 
 extern bool EnableLogNMEA;
 
+/**
+ * Switches the NMEA log on or off.  If the file could not be opened
+ * before, the next line retries.
+ */
+void
+RawLoggerEnable(bool enable);
+
 void
 RawLoggerShutdown();
 
 /**
- * Logs NMEA string to log file
+ * Returns the number of NMEA lines which were dropped because the
+ * background writer could not keep up.
+ */
+unsigned
+RawLoggerOverflows();
+
+/**
+ * Logs NMEA string to log file.  The line is only copied into a
+ * memory buffer; a background thread writes it to the file.
  * @param text
  */
 void
@@ -271,23 +271,82 @@ private:
 #else // !ENABLE_OPENGL
 
 /**
- * Class to render airspaces onto map in two passes,
- * one for border, one for area.
- * This is a bit slow because projections are performed twice.
- * The old way of doing it was possibly faster but required a lot
- * of code overhead.
+ * Collects the airspaces to be drawn, and projects the ones which
+ * are not in the renderer's shape cache yet.
  */
-class AirspaceVisitorMap: 
-  public AirspaceVisitor,
-  public MapDrawHelper
+class AirspaceShapeCollector
+  :public AirspaceVisitor,
+   protected MapCanvas
+{
+  AirspaceRenderer &renderer;
+  std::vector<AirspaceRenderer::DrawItem> &items;
+
+public:
+  AirspaceShapeCollector(Canvas &_canvas, const WindowProjection &_projection,
+                         AirspaceRenderer &_renderer,
+                         std::vector<AirspaceRenderer::DrawItem> &_items)
+    :MapCanvas(_canvas, _projection,
+               _projection.GetScreenBounds().scale(fixed(1.1))),
+     renderer(_renderer), items(_items) {}
+
+private:
+  void Add(const AbstractAirspace &airspace,
+           const AirspaceRenderer::ScreenShape *shape) {
+    AirspaceRenderer::DrawItem item;
+    item.airspace = &airspace;
+    item.shape = shape;
+    items.push_back(item);
+  }
+
+public:
+  void Visit(const AirspaceCircle& airspace) {
+    const AirspaceRenderer::ScreenShape *shape =
+      renderer.FindShape(airspace);
+    if (shape == NULL) {
+      AirspaceRenderer::ScreenShape s;
+      s.circle = true;
+      s.center = projection.GeoToScreen(airspace.get_center());
+      s.radius = projection.GeoToScreenDistance(airspace.get_radius());
+      s.first_point = s.num_points = 0;
+      shape = renderer.AddShape(airspace, s, NULL);
+    }
+
+    Add(airspace, shape);
+  }
+
+  void Visit(const AirspacePolygon& airspace) {
+    const AirspaceRenderer::ScreenShape *shape =
+      renderer.FindShape(airspace);
+    if (shape == NULL) {
+      AirspaceRenderer::ScreenShape s;
+      s.circle = false;
+      s.radius = 0;
+      s.num_points = prepare_polygon(airspace.get_points())
+        ? num_raster_points
+        : 0;
+      shape = renderer.AddShape(airspace, s, raster_points.begin());
+    }
+
+    if (shape->num_points > 0)
+      Add(airspace, shape);
+  }
+};
+
+/**
+ * Fills the airspace areas into the buffer, and copies the buffer
+ * onto the map.
+ */
+class AirspaceFillRenderer: public MapDrawHelper
 {
   const AirspaceLook &airspace_look;
+  const AirspaceWarningCopy& m_warnings;
+  Pen pen_thick;
+  Pen pen_medium;
 
 public:
-  AirspaceVisitorMap(MapDrawHelper &_helper,
-                     const AirspaceWarningCopy& warnings,
-                     const AirspaceRendererSettings &_settings,
-                     const AirspaceLook &_airspace_look)
+  AirspaceFillRenderer(MapDrawHelper &_helper,
+                       const AirspaceWarningCopy& warnings,
+                       const AirspaceLook &_airspace_look)
     :MapDrawHelper(_helper),
      airspace_look(_airspace_look),
      m_warnings(warnings),
@@ -309,25 +368,19 @@ public:
     }
   }
 
-  void Visit(const AirspaceCircle& airspace) {
+  void Draw(const AbstractAirspace &airspace,
+            const AirspaceRenderer::ScreenShape &shape,
+            const RasterPoint *points) {
     if (m_warnings.is_acked(airspace))
       return;
 
     buffer_render_start();
     set_buffer_pens(airspace);
 
-    RasterPoint center = m_proj.GeoToScreen(airspace.get_center());
-    unsigned radius = m_proj.GeoToScreenDistance(airspace.get_radius());
-    draw_circle(m_buffer, center, radius);
-  }
-
-  void Visit(const AirspacePolygon& airspace) {
-    if (m_warnings.is_acked(airspace))
-      return;
-
-    buffer_render_start();
-    set_buffer_pens(airspace);
-    draw_search_point_vector(m_buffer, airspace.get_points());
+    if (shape.circle)
+      draw_circle(m_buffer, shape.center, shape.radius);
+    else
+      draw_polygon(m_buffer, points, shape.num_points);
   }
 
   void draw_intercepts() {
@@ -371,25 +424,18 @@ private:
 
 #endif /* HAVE_HATCHED_BRUSH */
   }
-
-  const AirspaceWarningCopy& m_warnings;
-  Pen pen_thick;
-  Pen pen_medium;
 };
 
 class AirspaceOutlineRenderer
-  :public AirspaceVisitor,
-   protected MapCanvas
 {
+  Canvas &canvas;
   const AirspaceLook &airspace_look;
   bool black;
 
 public:
-  AirspaceOutlineRenderer(Canvas &_canvas, const WindowProjection &_projection,
-                          const AirspaceLook &_airspace_look,
+  AirspaceOutlineRenderer(Canvas &_canvas, const AirspaceLook &_airspace_look,
                           bool _black)
-    :MapCanvas(_canvas, _projection,
-               _projection.GetScreenBounds().scale(fixed(1.1))),
+    :canvas(_canvas),
      airspace_look(_airspace_look),
      black(_black) {
     if (black)
@@ -397,24 +443,93 @@ public:
     canvas.hollow_brush();
   }
 
-protected:
-  void setup_canvas(const AbstractAirspace &airspace) {
+  void Draw(const AbstractAirspace &airspace,
+            const AirspaceRenderer::ScreenShape &shape,
+            const RasterPoint *points) {
     if (!black)
       canvas.select(airspace_look.pens[airspace.get_type()]);
-  }
 
-public:
-  void Visit(const AirspaceCircle& airspace) {
-    setup_canvas(airspace);
-    circle(airspace.get_center(), airspace.get_radius());
-  }
-
-  void Visit(const AirspacePolygon& airspace) {
-    setup_canvas(airspace);
-    draw(airspace.get_points());
+    if (shape.circle)
+      canvas.circle(shape.center.x, shape.center.y, shape.radius);
+    else
+      canvas.polygon(points, shape.num_points);
   }
 };
 
+void
+AirspaceRenderer::ValidateShapes(const WindowProjection &projection)
+{
+  const unsigned serial = airspace_database->GetSerial();
+  if (projection.GetScreenWidth() == shapes_width &&
+      projection.GetScreenHeight() == shapes_height &&
+      serial == shapes_serial &&
+      projection.GetGeoLocation() == shapes_location &&
+      projection.GetScale() == shapes_scale &&
+      projection.GetScreenAngle() == shapes_angle &&
+      projection.GetScreenOrigin().x == shapes_origin.x &&
+      projection.GetScreenOrigin().y == shapes_origin.y)
+    return;
+
+  shapes.clear();
+  shape_points.clear();
+
+  shapes_width = projection.GetScreenWidth();
+  shapes_height = projection.GetScreenHeight();
+  shapes_serial = serial;
+  shapes_location = projection.GetGeoLocation();
+  shapes_scale = projection.GetScale();
+  shapes_angle = projection.GetScreenAngle();
+  shapes_origin = projection.GetScreenOrigin();
+}
+
+const AirspaceRenderer::ScreenShape *
+AirspaceRenderer::FindShape(const AbstractAirspace &airspace) const
+{
+  std::map<const AbstractAirspace *, ScreenShape>::const_iterator i =
+    shapes.find(&airspace);
+  return i != shapes.end() ? &i->second : NULL;
+}
+
+const AirspaceRenderer::ScreenShape *
+AirspaceRenderer::AddShape(const AbstractAirspace &airspace,
+                           ScreenShape shape, const RasterPoint *points)
+{
+  shape.first_point = shape_points.size();
+  shape_points.insert(shape_points.end(), points, points + shape.num_points);
+
+  return &shapes.insert(std::make_pair(&airspace, shape)).first->second;
+}
+
+void
+AirspaceRenderer::DrawFill(Canvas &canvas,
+                           Canvas &buffer_canvas, Canvas &stencil_canvas,
+                           const WindowProjection &projection,
+                           const SETTINGS_MAP &settings_map,
+                           const AirspaceWarningCopy &warnings) const
+{
+  MapDrawHelper helper(canvas, buffer_canvas, stencil_canvas, projection,
+                       settings_map.airspace);
+  AirspaceFillRenderer renderer(helper, warnings, airspace_look);
+
+  for (std::vector<DrawItem>::const_iterator i = draw_items.begin();
+       i != draw_items.end(); ++i)
+    renderer.Draw(*i->airspace, *i->shape, GetShapePoints(*i->shape));
+
+  renderer.draw_intercepts();
+}
+
+void
+AirspaceRenderer::DrawOutline(Canvas &canvas,
+                              const SETTINGS_MAP &settings_map) const
+{
+  AirspaceOutlineRenderer renderer(canvas, airspace_look,
+                                   settings_map.airspace.black_outline);
+
+  for (std::vector<DrawItem>::const_iterator i = draw_items.begin();
+       i != draw_items.end(); ++i)
+    renderer.Draw(*i->airspace, *i->shape, GetShapePoints(*i->shape));
+}
+
 #endif // !ENABLE_OPENGL
 
 void
@@ -463,31 +578,22 @@ AirspaceRenderer::Draw(Canvas &canvas,
                                         projection.GetScreenDistanceMeters(),
                                         renderer, visible);
 #else
-  MapDrawHelper helper(canvas, buffer_canvas, stencil_canvas, projection,
-                       settings_map.airspace);
-  AirspaceVisitorMap v(helper, awc, settings_map.airspace,
-                       airspace_look);
-
-  // JMW TODO wasteful to draw twice, can't it be drawn once?
-  // we are using two draws so borders go on top of everything
-
-  airspace_database->visit_within_range(projection.GetGeoScreenCenter(),
-                                        projection.GetScreenDistanceMeters(),
-                                        v, visible);
-
-  awc.visit_warned(v);
-  awc.visit_inside(v);
-
-  v.draw_intercepts();
+  ValidateShapes(projection);
 
-  AirspaceOutlineRenderer outline_renderer(canvas, projection,
-                                           airspace_look,
-                                           settings_map.airspace.black_outline);
+  /* query the visible airspaces and project them only once; the
+     warned ones are added again to be drawn on top */
+  draw_items.clear();
+  AirspaceShapeCollector collector(canvas, projection, *this, draw_items);
   airspace_database->visit_within_range(projection.GetGeoScreenCenter(),
                                         projection.GetScreenDistanceMeters(),
-                                        outline_renderer, visible);
-  awc.visit_warned(outline_renderer);
-  awc.visit_inside(outline_renderer);
+                                        collector, visible);
+  awc.visit_warned(collector);
+  awc.visit_inside(collector);
+
+  /* fill first, then draw the borders on top of everything */
+  DrawFill(canvas, buffer_canvas, stencil_canvas, projection, settings_map,
+           awc);
+  DrawOutline(canvas, settings_map);
 #endif
 
   m_airspace_intersections = awc.get_locations();
@@ -26,6 +26,16 @@ Copyright_License {
 
 #include "StaticArray.hpp"
 #include "Engine/Navigation/GeoPoint.hpp"
+#include "Compiler.h"
+
+#ifndef ENABLE_OPENGL
+#include "Screen/Point.hpp"
+#include "Math/fixed.hpp"
+#include "Math/Angle.hpp"
+
+#include <vector>
+#include <map>
+#endif
 
 struct AirspaceLook;
 struct MoreData;
@@ -33,6 +43,8 @@ struct DERIVED_INFO;
 struct SETTINGS_COMPUTER;
 struct SETTINGS_MAP;
 class Airspaces;
+class AbstractAirspace;
+class AirspaceWarningCopy;
 class ProtectedAirspaceWarningManager;
 class Canvas;
 class WindowProjection;
@@ -46,10 +58,61 @@ class AirspaceRenderer
 
   StaticArray<GeoPoint,32> m_airspace_intersections;
 
+#ifndef ENABLE_OPENGL
+public:
+  /**
+   * The clipped screen shape of one airspace.
+   */
+  struct ScreenShape {
+    bool circle;
+
+    /** The circle center and radius (only valid if #circle is set) */
+    RasterPoint center;
+    unsigned radius;
+
+    /**
+     * The polygon vertices in #shape_points; #num_points is 0 if the
+     * polygon is not visible
+     */
+    unsigned first_point, num_points;
+  };
+
+private:
+  struct DrawItem {
+    const AbstractAirspace *airspace;
+    const ScreenShape *shape;
+  };
+
+  /**
+   * The projected shapes of all airspaces drawn with the current
+   * projection.  They are reused until the projection or the
+   * airspace database changes.
+   */
+  std::map<const AbstractAirspace *, ScreenShape> shapes;
+  std::vector<RasterPoint> shape_points;
+
+  /** The parameters #shapes was calculated with */
+  unsigned shapes_serial;
+  GeoPoint shapes_location;
+  fixed shapes_scale;
+  Angle shapes_angle;
+  RasterPoint shapes_origin;
+  unsigned shapes_width, shapes_height;
+
+  /** The airspaces to be drawn in the current frame, in order */
+  std::vector<DrawItem> draw_items;
+#endif
+
 public:
   AirspaceRenderer(const AirspaceLook &_airspace_look)
     :airspace_look(_airspace_look),
      airspace_database(NULL), airspace_warnings(NULL)
+#ifndef ENABLE_OPENGL
+    , shapes_serial(0),
+     shapes_location(Angle::native(fixed_zero), Angle::native(fixed_zero)),
+     shapes_scale(fixed_zero), shapes_angle(Angle::native(fixed_zero)),
+     shapes_width(0), shapes_height(0)
+#endif
   {}
 
   const AirspaceLook &GetLook() const {
@@ -68,6 +131,10 @@ public:
                     const ProtectedAirspaceWarningManager *_airspace_warnings) {
     airspace_database = _airspace_database;
     airspace_warnings = _airspace_warnings;
+#ifndef ENABLE_OPENGL
+    shapes.clear();
+    shape_points.clear();
+#endif
   }
 
   void Draw(Canvas &canvas,
@@ -81,6 +148,38 @@ public:
 
   void DrawIntersections(Canvas &canvas,
                          const WindowProjection &projection) const;
+
+#ifndef ENABLE_OPENGL
+private:
+  friend class AirspaceShapeCollector;
+
+  /**
+   * Clears the shape cache if the projection or the airspace
+   * database has changed since it was filled.
+   */
+  void ValidateShapes(const WindowProjection &projection);
+
+  gcc_pure
+  const ScreenShape *FindShape(const AbstractAirspace &airspace) const;
+
+  /**
+   * Adds a shape to the cache.  The polygon vertices are copied from
+   * the specified array.
+   */
+  const ScreenShape *AddShape(const AbstractAirspace &airspace,
+                              ScreenShape shape, const RasterPoint *points);
+
+  const RasterPoint *GetShapePoints(const ScreenShape &shape) const {
+    return shape.num_points > 0 ? &shape_points[shape.first_point] : NULL;
+  }
+
+  void DrawFill(Canvas &canvas, Canvas &buffer_canvas, Canvas &stencil_canvas,
+                const WindowProjection &projection,
+                const SETTINGS_MAP &settings_map,
+                const AirspaceWarningCopy &warnings) const;
+
+  void DrawOutline(Canvas &canvas, const SETTINGS_MAP &settings_map) const;
+#endif
 };
 
 #endif
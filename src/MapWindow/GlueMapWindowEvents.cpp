@@ -335,6 +335,8 @@ GlueMapWindow::Render(Canvas &canvas, const PixelRect &rc)
   MapWindow::Render(canvas, rc);
 
   if (!settings_map.EnablePan) {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_OVERLAYS);
+
     if (settings_map.EnableThermalProfile)
       DrawThermalBand(canvas, rc);
     DrawStallRatio(canvas, rc);
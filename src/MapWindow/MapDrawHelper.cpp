@@ -27,13 +27,11 @@ Copyright_License {
 #include "Screen/Canvas.hpp"
 #include "WindowProjection.hpp"
 #include "Airspace/AirspaceRendererSettings.hpp"
-#include "MapCanvas.hpp"
 
 MapDrawHelper::MapDrawHelper(Canvas &_canvas, Canvas &_buffer, Canvas &_stencil,
                              const WindowProjection &_proj,
                              const AirspaceRendererSettings &_settings)
-  :clip(_proj.GetScreenBounds().scale(fixed(1.1))),
-   m_canvas(_canvas),
+  :m_canvas(_canvas),
    m_buffer(_buffer),
    m_stencil(_stencil),
    m_proj(_proj),
@@ -44,8 +42,7 @@ MapDrawHelper::MapDrawHelper(Canvas &_canvas, Canvas &_buffer, Canvas &_stencil,
 }
 
 MapDrawHelper::MapDrawHelper(MapDrawHelper &_that)
-  :clip(_that.clip),
-   m_canvas(_that.m_canvas),
+  :m_canvas(_that.m_canvas),
    m_buffer(_that.m_buffer),
    m_stencil(_that.m_stencil),
    m_proj(_that.m_proj),
@@ -55,36 +52,13 @@ MapDrawHelper::MapDrawHelper(MapDrawHelper &_that)
 {
 }
 
-void 
-MapDrawHelper::draw_search_point_vector(Canvas& the_canvas, 
-                                        const SearchPointVector& points) 
+void
+MapDrawHelper::draw_polygon(Canvas &the_canvas,
+                            const RasterPoint *screen, unsigned num)
 {
-  size_t size = points.size();
-  if (size < 3)
-    return;
-
-  /* copy all SearchPointVector elements to geo_points */
-  geo_points.grow_discard(size * 3);
-  for (unsigned i = 0; i < size; ++i)
-    geo_points[i] = points[i].get_location();
-
-  /* clip them */
-  size = clip.clip_polygon(geo_points.begin(), geo_points.begin(), size);
-  if (size < 3)
-    /* it's completely outside the screen */
-    return;
-
-  /* draw it all */
-  RasterPoint screen[size];
-  for (unsigned i = 0; i < size; ++i)
-    screen[i] = m_proj.GeoToScreen(geo_points[i]);
-
-  if (!MapCanvas::visible(the_canvas, screen, size))
-    return;
-
-  the_canvas.polygon(&screen[0], size);
+  the_canvas.polygon(screen, num);
   if (m_use_stencil)
-    m_stencil.polygon(&screen[0], size);
+    m_stencil.polygon(screen, num);
 }
 
 void 
@@ -26,10 +26,7 @@ Copyright_License {
 
 #ifndef ENABLE_OPENGL
 
-#include "Navigation/SearchPointVector.hpp"
 #include "Screen/Point.hpp"
-#include "Geo/GeoClip.hpp"
-#include "Util/AllocatedArray.hpp"
 
 class Canvas;
 class Projection;
@@ -41,13 +38,6 @@ struct AirspaceRendererSettings;
  */
 class MapDrawHelper
 {
-  const GeoClip clip;
-
-  /**
-   * A variable-length buffer for clipped GeoPoints.
-   */
-  AllocatedArray<GeoPoint> geo_points;
-
 public:
   Canvas &m_canvas;
   Canvas &m_buffer;
@@ -68,8 +58,8 @@ public:
   MapDrawHelper(MapDrawHelper &_that);
 
 protected:
-  void draw_search_point_vector(Canvas& the_canvas,
-                                const SearchPointVector& points);
+  void draw_polygon(Canvas &the_canvas,
+                    const RasterPoint *screen, unsigned num);
 
   void draw_circle(Canvas &the_canvas,
                    const RasterPoint &center, unsigned radius);
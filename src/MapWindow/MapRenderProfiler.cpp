@@ -0,0 +1,199 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "MapRenderProfiler.hpp"
+#include "IO/TextWriter.hpp"
+
+#include <algorithm>
+#include <string.h>
+
+static const TCHAR *const layer_names[MapRenderProfiler::NUM_LAYERS] = {
+  _T("terrain"),
+  _T("topography"),
+  _T("final_glide_shading"),
+  _T("track_bearing"),
+  _T("airspace"),
+  _T("task"),
+  _T("waypoints"),
+  _T("spot_heights"),
+  _T("trail"),
+  _T("marks"),
+  _T("thermal_estimate"),
+  _T("topography_labels"),
+  _T("glide"),
+  _T("cruise_track"),
+  _T("airspace_intersections"),
+  _T("wind"),
+  _T("traffic"),
+  _T("aircraft"),
+  _T("compass"),
+  _T("overlays"),
+};
+
+MapRenderProfiler::MapRenderProfiler()
+  :enabled(false), overlay(false), frame_active(false),
+   window_head(0), window_count(0), frame_number(0),
+   csv(NULL) {}
+
+MapRenderProfiler::~MapRenderProfiler()
+{
+  delete csv;
+}
+
+const TCHAR *
+MapRenderProfiler::GetLayerName(unsigned layer)
+{
+  assert(layer < NUM_LAYERS);
+
+  return layer_names[layer];
+}
+
+bool
+MapRenderProfiler::OpenCSV(const TCHAR *path)
+{
+  TextWriter *writer = new TextWriter(path);
+  if (writer->error()) {
+    delete writer;
+    return false;
+  }
+
+  ScopeLock protect(mutex);
+  delete csv;
+  csv = writer;
+  WriteCSVHeader();
+  return true;
+}
+
+void
+MapRenderProfiler::CloseCSV()
+{
+  ScopeLock protect(mutex);
+  delete csv;
+  csv = NULL;
+}
+
+void
+MapRenderProfiler::Reset()
+{
+  ScopeLock protect(mutex);
+  window_head = window_count = 0;
+  frame_number = 0;
+}
+
+void
+MapRenderProfiler::BeginFrame()
+{
+  frame_active = enabled;
+  if (!frame_active)
+    return;
+
+  memset(&current, 0, sizeof(current));
+  frame_start = MonotonicClockUS();
+}
+
+void
+MapRenderProfiler::EndFrame()
+{
+  if (!frame_active)
+    return;
+
+  frame_active = false;
+  current.total = MonotonicClockUS() - frame_start;
+
+  ScopeLock protect(mutex);
+
+  window[window_head] = current;
+  window_head = (window_head + 1) % WINDOW_SIZE;
+  if (window_count < WINDOW_SIZE)
+    ++window_count;
+
+  ++frame_number;
+
+  if (csv != NULL)
+    WriteCSVFrame(current);
+}
+
+void
+MapRenderProfiler::WriteCSVHeader()
+{
+  csv->write("frame,total");
+  for (unsigned i = 0; i < NUM_LAYERS; ++i) {
+    csv->write(',');
+    csv->write(layer_names[i]);
+  }
+
+  csv->newline();
+}
+
+void
+MapRenderProfiler::WriteCSVFrame(const Frame &frame)
+{
+  csv->printf("%u,%u", frame_number, frame.total);
+  for (unsigned i = 0; i < NUM_LAYERS; ++i)
+    csv->printf(",%u", frame.layers[i]);
+
+  csv->newline();
+}
+
+MapRenderProfiler::Summary
+MapRenderProfiler::Summarise(unsigned column) const
+{
+  Summary summary;
+  summary.count = window_count;
+  summary.mean = summary.p50 = summary.p95 = summary.max = 0;
+
+  if (window_count == 0)
+    return summary;
+
+  unsigned values[WINDOW_SIZE];
+  unsigned long sum = 0;
+  for (unsigned i = 0; i < window_count; ++i) {
+    const Frame &frame = window[i];
+    values[i] = column < NUM_LAYERS ? frame.layers[column] : frame.total;
+    sum += values[i];
+  }
+
+  std::sort(values, values + window_count);
+
+  summary.mean = sum / window_count;
+  summary.p50 = values[(window_count - 1) * 50 / 100];
+  summary.p95 = values[(window_count - 1) * 95 / 100];
+  summary.max = values[window_count - 1];
+  return summary;
+}
+
+MapRenderProfiler::Summary
+MapRenderProfiler::GetFrameSummary() const
+{
+  ScopeLock protect(mutex);
+  return Summarise(NUM_LAYERS);
+}
+
+MapRenderProfiler::Summary
+MapRenderProfiler::GetLayerSummary(Layer layer) const
+{
+  assert(layer < NUM_LAYERS);
+
+  ScopeLock protect(mutex);
+  return Summarise(layer);
+}
@@ -0,0 +1,221 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_MAP_RENDER_PROFILER_HPP
+#define XCSOAR_MAP_RENDER_PROFILER_HPP
+
+#include "Thread/Mutex.hpp"
+#include "OS/Clock.hpp"
+#include "Compiler.h"
+
+#include <assert.h>
+#include <tchar.h>
+
+class TextWriter;
+
+/**
+ * Records how long each layer of the moving map takes to draw.  The
+ * durations of the most recent frames are kept in a ring buffer,
+ * from which rolling percentiles are calculated.  Optionally, every
+ * frame is appended to a CSV file.
+ *
+ * The profiler is disabled by default.  Frames are only recorded
+ * while it is enabled, so the cost of a disabled profiler is one
+ * flag check per layer.
+ */
+class MapRenderProfiler : private NonCopyable {
+public:
+  enum Layer {
+    LAYER_TERRAIN,
+    LAYER_TOPOGRAPHY,
+    LAYER_FINAL_GLIDE_SHADING,
+    LAYER_TRACK_BEARING,
+    LAYER_AIRSPACE,
+    LAYER_TASK,
+    LAYER_WAYPOINTS,
+    LAYER_SPOT_HEIGHTS,
+    LAYER_TRAIL,
+    LAYER_MARKS,
+    LAYER_THERMAL_ESTIMATE,
+    LAYER_TOPOGRAPHY_LABELS,
+    LAYER_GLIDE,
+    LAYER_CRUISE_TRACK,
+    LAYER_AIRSPACE_INTERSECTIONS,
+    LAYER_WIND,
+    LAYER_TRAFFIC,
+    LAYER_AIRCRAFT,
+    LAYER_COMPASS,
+    /** the gauges drawn by #GlueMapWindow on top of the map */
+    LAYER_OVERLAYS,
+    NUM_LAYERS
+  };
+
+  enum {
+    /**
+     * The number of frames the rolling percentiles are calculated
+     * from.
+     */
+    WINDOW_SIZE = 64,
+  };
+
+  /**
+   * Percentiles of one layer (or the whole frame) in microseconds.
+   */
+  struct Summary {
+    unsigned count;
+    unsigned mean, p50, p95, max;
+  };
+
+private:
+  struct Frame {
+    unsigned total;
+    unsigned layers[NUM_LAYERS];
+  };
+
+  bool enabled, overlay;
+
+  /**
+   * Is a frame being recorded right now?  Only accessed by the
+   * drawing thread.
+   */
+  bool frame_active;
+  unsigned frame_start;
+  Frame current;
+
+  mutable Mutex mutex;
+
+  Frame window[WINDOW_SIZE];
+  unsigned window_head, window_count;
+
+  unsigned frame_number;
+
+  TextWriter *csv;
+
+public:
+  MapRenderProfiler();
+  ~MapRenderProfiler();
+
+  bool IsEnabled() const {
+    return enabled;
+  }
+
+  void SetEnabled(bool _enabled) {
+    enabled = _enabled;
+  }
+
+  /**
+   * Shall the summary be drawn on the map?
+   */
+  bool IsOverlayEnabled() const {
+    return overlay;
+  }
+
+  void SetOverlayEnabled(bool _overlay) {
+    overlay = _overlay;
+  }
+
+  gcc_const
+  static const TCHAR *GetLayerName(unsigned layer);
+
+  /**
+   * Starts writing one line per recorded frame to the specified CSV
+   * file.  An existing file is truncated.
+   *
+   * @return false if the file could not be created
+   */
+  bool OpenCSV(const TCHAR *path);
+
+  void CloseCSV();
+
+  bool IsCSVOpen() const {
+    return csv != NULL;
+  }
+
+  /**
+   * Discards all recorded frames.
+   */
+  void Reset();
+
+  /**
+   * Called by the drawing thread before rendering a frame.
+   */
+  void BeginFrame();
+
+  /**
+   * Called by the drawing thread after rendering a frame.
+   */
+  void EndFrame();
+
+  bool IsFrameActive() const {
+    return frame_active;
+  }
+
+  void AddLayer(Layer layer, unsigned us) {
+    assert(frame_active);
+    assert(layer < NUM_LAYERS);
+
+    current.layers[layer] += us;
+  }
+
+  /**
+   * Returns the number of frames recorded since the last Reset().
+   */
+  unsigned GetFrameCount() const {
+    return frame_number;
+  }
+
+  Summary GetFrameSummary() const;
+  Summary GetLayerSummary(Layer layer) const;
+
+private:
+  void WriteCSVHeader();
+  void WriteCSVFrame(const Frame &frame);
+
+  gcc_pure
+  Summary Summarise(unsigned column) const;
+};
+
+/**
+ * Measures the lifetime of this object and adds it to one layer of
+ * the current frame.
+ */
+class ScopeLayerTimer {
+  MapRenderProfiler &profiler;
+  MapRenderProfiler::Layer layer;
+  bool active;
+  unsigned start;
+
+public:
+  ScopeLayerTimer(MapRenderProfiler &_profiler,
+                  MapRenderProfiler::Layer _layer)
+    :profiler(_profiler), layer(_layer),
+     active(_profiler.IsFrameActive()),
+     start(active ? MonotonicClockUS() : 0) {}
+
+  ~ScopeLayerTimer() {
+    if (active)
+      profiler.AddLayer(layer, MonotonicClockUS() - start);
+  }
+};
+
+#endif
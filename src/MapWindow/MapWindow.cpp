@@ -176,7 +176,12 @@ MapWindow::on_paint_buffer(Canvas &canvas)
 #endif
 
   // Render the moving map
+  render_profiler.BeginFrame();
   Render(canvas, get_client_rect());
+  render_profiler.EndFrame();
+
+  if (render_profiler.IsEnabled() && render_profiler.IsOverlayEnabled())
+    DrawRenderProfile(canvas, get_client_rect());
 
 #ifndef ENABLE_OPENGL
   // Stop the drawing timer and calculate drawing time
@@ -27,7 +27,9 @@ Copyright_License {
 #include "Util/StaticArray.hpp"
 #include "MapWindowProjection.hpp"
 #include "MapWindowTimer.hpp"
+#include "MapRenderProfiler.hpp"
 #include "AirspaceRenderer.hpp"
+#include "TrailRenderer.hpp"
 #include "Screen/DoubleBufferWindow.hpp"
 #ifndef ENABLE_OPENGL
 #include "Screen/BufferCanvas.hpp"
@@ -114,10 +116,14 @@ protected:
 
   AirspaceRenderer airspace_renderer;
 
+  TrailRenderer trail_renderer;
+
   ProtectedTaskManager *task;
 
   Marks *marks;
 
+  MapRenderProfiler render_profiler;
+
 #ifndef ENABLE_OPENGL
   /**
    * Tracks whether the buffer canvas contains valid data.  We use
@@ -184,6 +190,10 @@ public:
     visible_projection.SetGeoLocation(location);
   }
 
+  MapRenderProfiler &GetRenderProfiler() {
+    return render_profiler;
+  }
+
 public:
   void DrawBestCruiseTrack(Canvas &canvas,
                            const RasterPoint aircraft_pos) const;
@@ -195,8 +205,8 @@ public:
   void DrawWaypoints(Canvas &canvas);
 
   void DrawTrail(Canvas &canvas, const RasterPoint aircraft_pos,
-                 unsigned min_time, bool enable_traildrift = false) const;
-  virtual void RenderTrail(Canvas &canvas, const RasterPoint aircraft_pos) const;
+                 unsigned min_time, bool enable_traildrift = false);
+  virtual void RenderTrail(Canvas &canvas, const RasterPoint aircraft_pos);
   void DrawTeammate(Canvas &canvas) const;
   void DrawTask(Canvas &canvas);
   void DrawTaskOffTrackIndicator(Canvas &canvas);
@@ -278,6 +288,13 @@ private:
    */
   void RenderGlide(Canvas &canvas);
 
+  /**
+   * Draws the rolling summary of #render_profiler
+   * @param canvas The drawing canvas
+   * @param rc The area to draw in
+   */
+  void DrawRenderProfile(Canvas &canvas, const PixelRect &rc);
+
 public:
   void SetMapScale(const fixed x);
 };
@@ -27,6 +27,10 @@ Copyright_License {
 #include "Task/ProtectedTaskManager.hpp"
 #include "Units/Units.hpp"
 #include "Renderer/AircraftRenderer.hpp"
+#include "Screen/Fonts.hpp"
+
+#include <algorithm>
+#include <stdio.h>
 
 void
 MapWindow::RenderTerrain(Canvas &canvas)
@@ -107,55 +111,168 @@ MapWindow::Render(Canvas &canvas, const PixelRect &rc)
   label_block.reset();
 
   // Render terrain, groundline and topography
-  RenderTerrain(canvas);
-  RenderTopography(canvas);
-  RenderFinalGlideShading(canvas);
+  {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_TERRAIN);
+    RenderTerrain(canvas);
+  }
+
+  {
+    ScopeLayerTimer timer(render_profiler,
+                          MapRenderProfiler::LAYER_TOPOGRAPHY);
+    RenderTopography(canvas);
+  }
+
+  {
+    ScopeLayerTimer timer(render_profiler,
+                          MapRenderProfiler::LAYER_FINAL_GLIDE_SHADING);
+    RenderFinalGlideShading(canvas);
+  }
 
   // Render track bearing (ground track)
-  DrawTrackBearing(canvas, aircraft_pos);
+  {
+    ScopeLayerTimer timer(render_profiler,
+                          MapRenderProfiler::LAYER_TRACK_BEARING);
+    DrawTrackBearing(canvas, aircraft_pos);
+  }
 
   // Render airspace
-  RenderAirspace(canvas);
+  {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_AIRSPACE);
+    RenderAirspace(canvas);
+  }
 
   // Render task, waypoints
-  DrawTask(canvas);
-  DrawWaypoints(canvas);
+  {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_TASK);
+    DrawTask(canvas);
+  }
+
+  {
+    ScopeLayerTimer timer(render_profiler,
+                          MapRenderProfiler::LAYER_WAYPOINTS);
+    DrawWaypoints(canvas);
+  }
 
   // Render weather/terrain max/min values
-  if (!m_background.DrawSpotHeights(canvas, label_block))
-    DrawTaskOffTrackIndicator(canvas);
+  {
+    ScopeLayerTimer timer(render_profiler,
+                          MapRenderProfiler::LAYER_SPOT_HEIGHTS);
+    if (!m_background.DrawSpotHeights(canvas, label_block))
+      DrawTaskOffTrackIndicator(canvas);
+  }
 
   // Render the snail trail
-  RenderTrail(canvas, aircraft_pos);
+  {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_TRAIL);
+    RenderTrail(canvas, aircraft_pos);
+  }
 
-  RenderMarks(canvas);
+  {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_MARKS);
+    RenderMarks(canvas);
+  }
 
   // Render estimate of thermal location
-  DrawThermalEstimate(canvas);
+  {
+    ScopeLayerTimer timer(render_profiler,
+                          MapRenderProfiler::LAYER_THERMAL_ESTIMATE);
+    DrawThermalEstimate(canvas);
+  }
 
   // Render topography on top of airspace, to keep the text readable
-  RenderTopographyLabels(canvas);
+  {
+    ScopeLayerTimer timer(render_profiler,
+                          MapRenderProfiler::LAYER_TOPOGRAPHY_LABELS);
+    RenderTopographyLabels(canvas);
+  }
 
   // Render glide through terrain range
-  RenderGlide(canvas);
-
-  DrawBestCruiseTrack(canvas, aircraft_pos);
-
-  airspace_renderer.DrawIntersections(canvas, render_projection);
+  {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_GLIDE);
+    RenderGlide(canvas);
+  }
+
+  {
+    ScopeLayerTimer timer(render_profiler,
+                          MapRenderProfiler::LAYER_CRUISE_TRACK);
+    DrawBestCruiseTrack(canvas, aircraft_pos);
+  }
+
+  {
+    ScopeLayerTimer timer(render_profiler,
+                          MapRenderProfiler::LAYER_AIRSPACE_INTERSECTIONS);
+    airspace_renderer.DrawIntersections(canvas, render_projection);
+  }
 
   // Draw wind vector at aircraft
-  DrawWind(canvas, aircraft_pos, rc);
+  {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_WIND);
+    DrawWind(canvas, aircraft_pos, rc);
+  }
 
   // Draw traffic
-  DrawTeammate(canvas);
-  DrawFLARMTraffic(canvas, aircraft_pos);
+  {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_TRAFFIC);
+    DrawTeammate(canvas);
+    DrawFLARMTraffic(canvas, aircraft_pos);
+  }
 
   // Finally, draw you!
-  if (Basic().Connected)
+  if (Basic().Connected) {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_AIRCRAFT);
     DrawAircraft(canvas, settings_map, aircraft_look,
                  Calculated().Heading - render_projection.GetScreenAngle(),
                  aircraft_pos);
+  }
 
   // Render compass
-  DrawCompass(canvas, rc);
+  {
+    ScopeLayerTimer timer(render_profiler, MapRenderProfiler::LAYER_COMPASS);
+    DrawCompass(canvas, rc);
+  }
+}
+
+void
+MapWindow::DrawRenderProfile(Canvas &canvas, const PixelRect &rc)
+{
+  const MapRenderProfiler::Summary frame = render_profiler.GetFrameSummary();
+  if (frame.count == 0)
+    return;
+
+  MapRenderProfiler::Summary layers[MapRenderProfiler::NUM_LAYERS];
+  unsigned order[MapRenderProfiler::NUM_LAYERS];
+  for (unsigned i = 0; i < MapRenderProfiler::NUM_LAYERS; ++i) {
+    layers[i] = render_profiler.GetLayerSummary((MapRenderProfiler::Layer)i);
+    order[i] = i;
+  }
+
+  canvas.select(Fonts::Map);
+  canvas.set_text_color(COLOR_BLACK);
+  canvas.background_transparent();
+
+  const int line_height = canvas.text_height(_T("0"));
+  int y = rc.bottom - 4 * line_height;
+
+  // List the three most expensive layers (by 95th percentile)
+  TCHAR buffer[80];
+  for (unsigned n = 0; n < 3; ++n) {
+    unsigned best = n;
+    for (unsigned i = n + 1; i < MapRenderProfiler::NUM_LAYERS; ++i)
+      if (layers[order[i]].p95 > layers[order[best]].p95)
+        best = i;
+
+    std::swap(order[n], order[best]);
+
+    const MapRenderProfiler::Summary &layer = layers[order[n]];
+    _stprintf(buffer, _T("%s %.1f/%.1f"),
+              MapRenderProfiler::GetLayerName(order[n]),
+              layer.p50 / 1000., layer.p95 / 1000.);
+    canvas.text(rc.left, y, buffer);
+    y += line_height;
+  }
+
+  // Frame time summary in milliseconds: median/95th percentile
+  _stprintf(buffer, _T("frame %.1f/%.1f max %.1f ms"),
+            frame.p50 / 1000., frame.p95 / 1000., frame.max / 1000.);
+  canvas.text(rc.left, y, buffer);
 }
@@ -0,0 +1,230 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "MapWindow/TrailRenderer.hpp"
+#include "Trace/Trace.hpp"
+#include "WindowProjection.hpp"
+#include "SettingsMap.hpp"
+#include "Screen/Canvas.hpp"
+#include "Screen/Graphics.hpp"
+
+#include <algorithm>
+
+using std::min;
+using std::max;
+
+/**
+ * This function returns the corresponding SnailTrail
+ * color array index to the input
+ * @param cv Input value between -1.0 and 1.0
+ * @return SnailTrail color array index
+ */
+gcc_const
+static int
+GetSnailColorIndex(fixed cv)
+{
+  return max((short)0, min((short)(NUMSNAILCOLORS - 1),
+                           (short)((cv + fixed_one) / 2 * NUMSNAILCOLORS)));
+}
+
+/**
+ * Checks whether the first points of the new copy are the same as
+ * the old copy, i.e. points were only appended.
+ */
+gcc_pure
+static bool
+IsPrefix(const TracePointVector &old_trace, const TracePointVector &new_trace)
+{
+  if (old_trace.size() > new_trace.size())
+    return false;
+
+  for (unsigned i = 0; i < old_trace.size(); ++i)
+    if (old_trace[i].time != new_trace[i].time)
+      return false;
+
+  return true;
+}
+
+bool
+TrailRenderer::LoadTrace(const Trace &src, const WindowProjection &projection)
+{
+  if (src.empty()) {
+    trace.clear();
+    trace_valid = false;
+    num_projected = 0;
+    return false;
+  }
+
+  const unsigned range =
+    src.ProjectRange(projection.GetGeoScreenCenter(),
+                     projection.DistancePixelsToMeters(3));
+
+  if (trace_valid && src.GetSerial() == trace_serial && range == trace_range)
+    return !trace.empty();
+
+  TracePointVector new_trace;
+  new_trace.reserve(src.size());
+  const unsigned sq_range = range * range;
+  Trace::const_iterator end = src.end();
+  for (Trace::const_iterator i = src.begin(); i != end;
+       i.NextSquareRange(sq_range, end))
+    new_trace.push_back(*i);
+
+  /* the screen coordinates of an unchanged prefix remain valid */
+  if (!IsPrefix(trace, new_trace))
+    num_projected = 0;
+
+  trace.swap(new_trace);
+  trace_serial = src.GetSerial();
+  trace_range = range;
+  trace_valid = true;
+
+  locations.grow_discard(trace.size());
+  for (unsigned i = 0; i < trace.size(); ++i)
+    locations[i] = trace[i].get_location();
+
+  UpdateRanges();
+
+  return !trace.empty();
+}
+
+void
+TrailRenderer::UpdateRanges()
+{
+  altitude_max = fixed(1000);
+  altitude_min = fixed(500);
+  vario_max = fixed(0.75);
+  vario_min = fixed(-2.0);
+
+  for (TracePointVector::const_iterator it = trace.begin();
+       it != trace.end(); ++it) {
+    altitude_max = max(it->GetAltitude(), altitude_max);
+    altitude_min = min(it->GetAltitude(), altitude_min);
+    vario_max = max(it->GetVario(), vario_max);
+    vario_min = min(it->GetVario(), vario_min);
+  }
+
+  vario_max = min(fixed(7.5), vario_max);
+  vario_min = max(fixed(-5.0), vario_min);
+}
+
+bool
+TrailRenderer::IsProjectionCurrent(const Projection &projection) const
+{
+  return projection.GetGeoLocation() == projected_location &&
+    projection.GetScale() == projected_scale &&
+    projection.GetScreenAngle() == projected_angle &&
+    projection.GetScreenOrigin().x == projected_origin.x &&
+    projection.GetScreenOrigin().y == projected_origin.y;
+}
+
+void
+TrailRenderer::SaveProjection(const Projection &projection)
+{
+  projected_location = projection.GetGeoLocation();
+  projected_scale = projection.GetScale();
+  projected_angle = projection.GetScreenAngle();
+  projected_origin = projection.GetScreenOrigin();
+}
+
+int
+TrailRenderer::GetColourIndex(const TracePoint &point, bool altitude) const
+{
+  if (altitude) {
+    int index = (point.GetAltitude() - altitude_min) /
+      (altitude_max - altitude_min) * (NUMSNAILCOLORS - 1);
+    return max(0, min(NUMSNAILCOLORS - 1, index));
+  } else {
+    const fixed colour_vario = negative(point.GetVario())
+      ? - point.GetVario() / vario_min
+      : point.GetVario() / vario_max;
+    return GetSnailColorIndex(colour_vario);
+  }
+}
+
+void
+TrailRenderer::Draw(Canvas &canvas, const WindowProjection &projection,
+                    const SETTINGS_MAP &settings_map, fixed time,
+                    const GeoPoint *traildrift, RasterPoint aircraft_pos)
+{
+  const unsigned n = trace.size();
+  if (n == 0)
+    return;
+
+  points.grow_preserve(n, num_projected);
+
+  if (traildrift == NULL) {
+    if (!IsProjectionCurrent(projection)) {
+      SaveProjection(projection);
+      num_projected = 0;
+    }
+
+    /* project only the points appended since the last frame */
+    projection.GeoToScreen(locations.begin() + num_projected,
+                           points.begin() + num_projected,
+                           n - num_projected);
+    num_projected = n;
+  } else {
+    /* drifting points move with every frame, nothing can be reused */
+    for (unsigned i = 0; i < n; ++i) {
+      const TracePoint &point = trace[i];
+      const fixed dt = time - fixed(point.time);
+      points[i] = projection.GeoToScreen(point.get_location().
+          parametric(*traildrift, dt * point.drift_factor / 256));
+    }
+
+    num_projected = 0;
+  }
+
+  const bool altitude = settings_map.SnailType == stAltitude;
+  const Pen *pens = altitude || !settings_map.SnailScaling ||
+    projection.GetMapScale() > fixed_int_constant(6000)
+    ? Graphics::hpSnail
+    : Graphics::hpSnailVario;
+
+  /* draw each run of segments with the same colour as one polyline;
+     segment i connects point i-1 to point i and has the colour of
+     point i */
+  unsigned run_start = 0;
+  int run_colour = -1;
+  for (unsigned i = 1; i < n; ++i) {
+    const int colour = GetColourIndex(trace[i], altitude);
+    if (colour == run_colour)
+      continue;
+
+    if (run_colour >= 0) {
+      canvas.select(pens[run_colour]);
+      canvas.polyline(points.begin() + run_start, i - run_start);
+    }
+
+    run_colour = colour;
+    run_start = i - 1;
+  }
+
+  if (run_colour >= 0) {
+    canvas.select(pens[run_colour]);
+    canvas.polyline(points.begin() + run_start, n - run_start);
+  }
+
+  canvas.line(points[n - 1], aircraft_pos);
+}
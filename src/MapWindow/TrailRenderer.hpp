@@ -0,0 +1,107 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TRAIL_RENDERER_HPP
+#define XCSOAR_TRAIL_RENDERER_HPP
+
+#include "Navigation/TracePoint.hpp"
+#include "Navigation/GeoPoint.hpp"
+#include "Util/AllocatedArray.hpp"
+#include "Screen/Point.hpp"
+#include "Math/fixed.hpp"
+#include "Math/Angle.hpp"
+
+struct SETTINGS_MAP;
+class Trace;
+class Canvas;
+class Projection;
+class WindowProjection;
+
+/**
+ * Draws the snail trail.  It keeps a thinned copy of the Trace and
+ * its screen coordinates between frames: the copy is refreshed only
+ * when the Trace has changed, and points are projected again only
+ * when the projection has changed.  Points appended to the trace are
+ * projected incrementally.
+ */
+class TrailRenderer {
+  /** A thinned copy of the Trace */
+  TracePointVector trace;
+
+  /** The Trace serial and thinning range of #trace */
+  unsigned trace_serial, trace_range;
+  bool trace_valid;
+
+  /** The ranges of altitude and vario in #trace */
+  fixed altitude_min, altitude_max, vario_min, vario_max;
+
+  /** The locations of #trace, as input for the batch projection */
+  AllocatedArray<GeoPoint> locations;
+
+  /** The screen coordinates of the first #num_projected points */
+  AllocatedArray<RasterPoint> points;
+  unsigned num_projected;
+
+  /** The projection parameters #points were calculated with */
+  GeoPoint projected_location;
+  fixed projected_scale;
+  Angle projected_angle;
+  RasterPoint projected_origin;
+
+public:
+  TrailRenderer()
+    :trace_valid(false), num_projected(0),
+     projected_location(Angle::native(fixed_zero), Angle::native(fixed_zero)),
+     projected_scale(fixed_zero), projected_angle(Angle::native(fixed_zero)) {}
+
+  /**
+   * Refreshes the copy of the trace, unless it is still current.
+   * The caller must hold a lease on the task manager.
+   *
+   * @return false if the trace is empty
+   */
+  bool LoadTrace(const Trace &src, const WindowProjection &projection);
+
+  /**
+   * Draws the trail loaded by LoadTrace().
+   *
+   * @param time the current time, for the trail drift
+   * @param traildrift the wind drift per second, or NULL if the
+   * trail shall not drift
+   */
+  void Draw(Canvas &canvas, const WindowProjection &projection,
+            const SETTINGS_MAP &settings_map, fixed time,
+            const GeoPoint *traildrift, RasterPoint aircraft_pos);
+
+private:
+  void UpdateRanges();
+
+  gcc_pure
+  bool IsProjectionCurrent(const Projection &projection) const;
+  void SaveProjection(const Projection &projection);
+
+  gcc_pure
+  int GetColourIndex(const TracePoint &point, bool altitude) const;
+};
+
+#endif
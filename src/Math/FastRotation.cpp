@@ -55,10 +55,3 @@ FastIntegerRotation::SetAngle(Angle _angle)
   cost = angle.ifastcosine();
   sint = angle.ifastsine();
 }
-
-FastIntegerRotation::Pair
-FastIntegerRotation::Rotate(int x, int y) const
-{
-  return Pair((x * cost - y * sint + 512) >> 10,
-              (y * cost + x * sint + 512) >> 10);
-}
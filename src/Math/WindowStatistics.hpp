@@ -0,0 +1,171 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WINDOW_STATISTICS_HPP
+#define XCSOAR_WINDOW_STATISTICS_HPP
+
+#include "Util/OverwritingRingBuffer.hpp"
+#include "Math/fixed.hpp"
+
+/**
+ * An #OverwritingRingBuffer of values which maintains running
+ * aggregates (sum, minimum, maximum and the least squares terms
+ * against the sample index) while values are pushed, so readers can
+ * query them in O(1) instead of iterating the window.
+ *
+ * The sample index ("x") is the position in the window, 0 being the
+ * oldest sample, which is also how the buffer is drawn.
+ *
+ * Not thread safe.
+ */
+template<unsigned max>
+class WindowStatistics : protected OverwritingRingBuffer<fixed, max> {
+  typedef OverwritingRingBuffer<fixed, max> Base;
+
+  unsigned count;
+
+  /** Sum of all values in the window */
+  fixed sum_y;
+
+  /** Sum of value * index for all values in the window */
+  fixed sum_xy;
+
+  fixed minimum, maximum;
+
+public:
+  typedef typename Base::const_iterator const_iterator;
+
+  WindowStatistics()
+    :count(0), sum_y(fixed_zero), sum_xy(fixed_zero),
+     minimum(fixed_zero), maximum(fixed_zero) {}
+
+  using Base::empty;
+  using Base::last;
+  using Base::begin;
+  using Base::end;
+  using Base::capacity;
+
+  void clear() {
+    Base::clear();
+    count = 0;
+    sum_y = sum_xy = minimum = maximum = fixed_zero;
+  }
+
+  void push(const fixed value) {
+    const bool full = Base::next(Base::tail) == Base::head;
+    fixed oldest = fixed_zero;
+    if (full) {
+      oldest = Base::peek();
+      sum_y -= oldest;
+      /* the remaining samples move one index towards the start */
+      sum_xy -= sum_y;
+      --count;
+    }
+
+    Base::push(value);
+
+    sum_xy += fixed(count) * value;
+    sum_y += value;
+    ++count;
+
+    if (full && (oldest == minimum || oldest == maximum))
+      /* the extreme value has left the window; this is rare enough
+         that a scan is cheaper than maintaining a sorted structure */
+      Rescan();
+    else if (count == 1)
+      minimum = maximum = value;
+    else if (value < minimum)
+      minimum = value;
+    else if (value > maximum)
+      maximum = value;
+  }
+
+  /**
+   * Returns the number of values in the window.
+   */
+  unsigned size() const {
+    return count;
+  }
+
+  fixed GetSum() const {
+    return sum_y;
+  }
+
+  fixed GetAverage() const {
+    return count > 0 ? sum_y / count : fixed_zero;
+  }
+
+  /**
+   * Returns the smallest value in the window, or zero if the window
+   * is empty.
+   */
+  fixed GetMinimum() const {
+    return minimum;
+  }
+
+  /**
+   * Returns the largest value in the window, or zero if the window
+   * is empty.
+   */
+  fixed GetMaximum() const {
+    return maximum;
+  }
+
+  /**
+   * Returns the slope of the least squares fit of the values over
+   * their index, i.e. the trend per sample.
+   */
+  fixed GetSlope() const {
+    if (count < 2)
+      return fixed_zero;
+
+    /* closed forms of the sums of the indices 0..n-1 and of their
+       squares */
+    const fixed n(count);
+    const fixed sum_x(count * (count - 1) / 2);
+    const fixed sum_xx((count - 1) * count * (2 * count - 1) / 6);
+
+    return (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x);
+  }
+
+private:
+  /**
+   * Recalculates all aggregates from the samples.  This also discards
+   * the rounding errors accumulated by the running sums.
+   */
+  void Rescan() {
+    sum_y = sum_xy = fixed_zero;
+    unsigned i = 0;
+    for (const_iterator it = begin(); it != end(); ++it, ++i) {
+      const fixed value = *it;
+      sum_y += value;
+      sum_xy += fixed(i) * value;
+      if (i == 0 || value < minimum)
+        minimum = value;
+      if (i == 0 || value > maximum)
+        maximum = value;
+    }
+  }
+};
+
+#endif
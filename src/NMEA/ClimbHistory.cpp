@@ -25,11 +25,24 @@ Copyright_License {
 
 #include <algorithm>
 
+ClimbHistory &
+ClimbHistory::operator=(const ClimbHistory &other)
+{
+  if (generation != other.generation) {
+    std::copy(other.vario, other.vario + SIZE, vario);
+    std::copy(other.count, other.count + SIZE, count);
+    generation = other.generation;
+  }
+
+  return *this;
+}
+
 void
 ClimbHistory::Clear()
 {
   std::fill(vario, vario + SIZE, fixed_zero);
   std::fill(count, count + SIZE, 0);
+  generation.Modified();
 }
 
 void
@@ -46,4 +59,5 @@ ClimbHistory::Add(unsigned speed, fixed _vario)
 
   vario[speed] += _vario;
   ++count[speed];
+  generation.Modified();
 }
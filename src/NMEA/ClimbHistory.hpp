@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_CLIMB_HISTORY_HPP
 
 #include "Math/fixed.hpp"
+#include "Util/Generation.hpp"
 
 #include <assert.h>
 
@@ -44,7 +45,16 @@ class ClimbHistory {
   /** Number of samples in each episode */
   unsigned short count[SIZE];
 
+  /** Changes whenever Clear() or Add() modifies this object */
+  Generation generation;
+
 public:
+  /**
+   * Copies the tables only if the other object has been modified
+   * since this one was last assigned from it.
+   */
+  ClimbHistory &operator=(const ClimbHistory &other);
+
   void Clear();
 
   void Add(unsigned speed, fixed vario);
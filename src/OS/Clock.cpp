@@ -55,6 +55,35 @@ MonotonicClockMS()
 #endif /* !HAVE_POSIX */
 }
 
+unsigned
+MonotonicClockUS()
+{
+#if defined(HAVE_POSIX) && !defined(__CYGWIN__)
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#elif defined(__APPLE__) /* OS X does not define CLOCK_MONOTONIC */
+  return mach_absolute_time() / 1000;
+#else
+  /* we have no monotonic clock, fall back to gettimeofday() */
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+  return tv.tv_sec * 1000000 + tv.tv_usec;
+#endif
+#else /* !HAVE_POSIX */
+  LARGE_INTEGER frequency, count;
+  if (!::QueryPerformanceFrequency(&frequency) ||
+      !::QueryPerformanceCounter(&count))
+    return ::GetTickCount() * 1000;
+
+  /* split the division to avoid an overflow after a long uptime */
+  return (unsigned)((count.QuadPart / frequency.QuadPart) * 1000000 +
+                    (count.QuadPart % frequency.QuadPart) * 1000000 /
+                    frequency.QuadPart);
+#endif /* !HAVE_POSIX */
+}
+
 int
 GetSystemUTCOffset()
 {
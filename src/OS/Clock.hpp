@@ -33,6 +33,15 @@ gcc_pure
 unsigned
 MonotonicClockMS();
 
+/**
+ * Returns the value of a monotonic clock in microseconds.  The value
+ * wraps around after about 71 minutes, so it is only suitable for
+ * measuring short durations.
+ */
+gcc_pure
+unsigned
+MonotonicClockUS();
+
 /**
  * Query the UTC offset from the OS.
  *
@@ -282,6 +282,8 @@ ProcessTimer::ConnectionProcessTimer(int itimeout)
        device is busy with that and will not send NMEA updates */
     return itimeout;
 
+  devRestartOnPortError();
+
   static bool connected_last = false;
   static bool location_last = false;
   static bool wait_connect = false;
@@ -77,6 +77,34 @@ Projection::GeoToScreen(const GeoPoint &g) const
   return sc;
 }
 
+void
+Projection::GeoToScreen(const GeoPoint *src, RasterPoint *dest,
+                        unsigned n) const
+{
+  /* copy the parameters to local variables; the stores to "dest"
+     would otherwise force the compiler to reload them for each
+     point */
+  const GeoPoint origin = GeoLocation;
+  const RasterPoint screen_origin = ScreenOrigin;
+  const FastIntegerRotation rotation = ScreenRotation;
+  const fixed draw_scale = DrawScale;
+
+  for (const GeoPoint *end = src + n; src != end; ++src, ++dest) {
+    const Angle d_longitude = (origin.Longitude - src->Longitude).as_delta();
+    const Angle d_latitude = origin.Latitude - src->Latitude;
+
+    const FastIntegerRotation::Pair p =
+      rotation.Rotate((int)fast_mult(src->Latitude.fastcosine(),
+                                     fast_mult(d_longitude.value_radians(),
+                                               draw_scale, 12), 16),
+                      (int)fast_mult(d_latitude.value_radians(),
+                                     draw_scale, 12));
+
+    dest->x = screen_origin.x - p.first;
+    dest->y = screen_origin.y + p.second;
+  }
+}
+
 void 
 Projection::SetScale(const fixed _scale)
 {
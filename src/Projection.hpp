@@ -131,6 +131,18 @@ public:
   gcc_pure
   RasterPoint GeoToScreen(const GeoPoint &g) const;
 
+  /**
+   * Converts an array of GeoPoints to screen coordinates.  This
+   * yields the same results as calling GeoToScreen() for each point,
+   * but is faster for long polylines and polygons.
+   *
+   * @param src the GeoPoints to convert
+   * @param dest the destination array, which must have room for n
+   * points
+   * @param n the number of points
+   */
+  void GeoToScreen(const GeoPoint *src, RasterPoint *dest, unsigned n) const;
+
   /**
    * Returns the origin/rotation center in screen coordinates
    * @return The origin/rotation center in screen coordinates
@@ -41,13 +41,8 @@ TraceHistoryRenderer::scale_chart(Chart &chart,
   chart.ScaleXFromValue(fixed(0));
   chart.ScaleXFromValue(fixed(var.capacity()-1));
 
-  fixed vmin = fixed_zero;
-  fixed vmax = fixed_zero;
-  for (TraceVariableHistory::const_iterator it = var.begin();
-       it != var.end(); ++it) {
-    vmin = std::min(*it, vmin);
-    vmax = std::max(*it, vmax);
-  }
+  fixed vmin = std::min(var.GetMinimum(), fixed_zero);
+  fixed vmax = std::max(var.GetMaximum(), fixed_zero);
   if (!(vmax>vmin)) {
     vmax += fixed_one;
   }
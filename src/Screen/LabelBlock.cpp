@@ -27,6 +27,10 @@ Copyright_License {
 void LabelBlock::reset()
 {
   blocks.clear();
+
+  for (unsigned i = 0; i < GRID_SIZE; ++i)
+    for (unsigned j = 0; j < GRID_SIZE; ++j)
+      buckets[i][j].clear();
 }
 
 static gcc_pure bool
@@ -36,15 +40,56 @@ CheckRectOverlap(const PixelRect& rc1, const PixelRect& rc2)
     rc1.top < rc2.bottom && rc1.bottom > rc2.top;
 }
 
+/**
+ * Returns the number of grid buckets between the two bucket
+ * coordinates (inclusive), at least one and at most the grid size.
+ */
+static gcc_const unsigned
+CountBuckets(int first, int last, unsigned grid_size)
+{
+  if (last <= first)
+    return 1;
+
+  const unsigned n = last - first + 1;
+  return n < grid_size ? n : grid_size;
+}
+
+bool
+LabelBlock::Overlaps(const PixelRect &rc,
+                     const std::vector<unsigned> &bucket) const
+{
+  for (std::vector<unsigned>::const_iterator i = bucket.begin(),
+         end = bucket.end(); i != end; ++i)
+    if (CheckRectOverlap(blocks[*i], rc))
+      return true;
+
+  return false;
+}
+
 bool LabelBlock::check(const PixelRect rc)
 {
-  for (BlockArray::const_iterator i = blocks.begin(), end = blocks.end();
-       i != end; ++i)
-    if (CheckRectOverlap(*i, rc))
-      return false;
+  /* the range of buckets covered by the rectangle; a rectangle wider
+     than the grid covers all of them */
+  const int first_x = rc.left >> BUCKET_SHIFT;
+  const int first_y = rc.top >> BUCKET_SHIFT;
+  const unsigned num_x = CountBuckets(first_x, (rc.right - 1) >> BUCKET_SHIFT,
+                                      GRID_SIZE);
+  const unsigned num_y = CountBuckets(first_y, (rc.bottom - 1) >> BUCKET_SHIFT,
+                                      GRID_SIZE);
+
+  for (unsigned y = 0; y < num_y; ++y)
+    for (unsigned x = 0; x < num_x; ++x)
+      if (Overlaps(rc, buckets[(first_y + y) & (GRID_SIZE - 1)]
+                   [(first_x + x) & (GRID_SIZE - 1)]))
+        return false;
+
+  const unsigned index = blocks.size();
+  blocks.push_back(rc);
 
-  if (!blocks.full())
-    blocks.append(rc);
+  for (unsigned y = 0; y < num_y; ++y)
+    for (unsigned x = 0; x < num_x; ++x)
+      buckets[(first_y + y) & (GRID_SIZE - 1)]
+        [(first_x + x) & (GRID_SIZE - 1)].push_back(index);
 
   return true;
 }
@@ -25,16 +25,42 @@ Copyright_License {
 #define SCREEN_LABELBLOCK_HPP
 
 #include "Screen/Point.hpp"
-#include "Util/StaticArray.hpp"
 #include "Compiler.h"
 
+#include <vector>
+
+/**
+ * Keeps track of the screen areas occupied by labels, to prevent
+ * text from being drawn over other text.
+ *
+ * The rectangles are sorted into a grid of buckets, so each check
+ * only needs to look at the labels nearby.  Screen coordinates wrap
+ * around the grid, which keeps it small regardless of the screen
+ * size.
+ */
 class LabelBlock {
-  typedef StaticArray<PixelRect, 256u> BlockArray;
+  static const unsigned BUCKET_SHIFT = 6;
+  static const unsigned GRID_SIZE = 16;
+
+  typedef std::vector<PixelRect> BlockArray;
   BlockArray blocks;
 
+  /** indices into #blocks, per bucket */
+  std::vector<unsigned> buckets[GRID_SIZE][GRID_SIZE];
+
 public:
+  /**
+   * Checks whether the rectangle overlaps any of the rectangles added
+   * before.  If not, it is added.
+   *
+   * @return true if the rectangle is free (and has been added)
+   */
   bool check(const PixelRect rc);
   void reset();
+
+private:
+  gcc_pure
+  bool Overlaps(const PixelRect &rc, const std::vector<unsigned> &bucket) const;
 };
 
 #endif
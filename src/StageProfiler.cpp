@@ -0,0 +1,132 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "StageProfiler.hpp"
+#include "LogFile.hpp"
+
+#include <algorithm>
+
+void
+TimingHistogram::Reset()
+{
+  std::fill(buckets, buckets + NUM_BUCKETS, 0u);
+  count = 0;
+  last = max = 0;
+  total = 0;
+}
+
+gcc_const
+static unsigned
+BucketIndex(unsigned us)
+{
+  unsigned i = 0;
+  while (us > 1 && i < TimingHistogram::NUM_BUCKETS - 1) {
+    us >>= 1;
+    ++i;
+  }
+
+  return i;
+}
+
+void
+TimingHistogram::Add(unsigned us)
+{
+  ++buckets[BucketIndex(us)];
+  ++count;
+  last = us;
+  if (us > max)
+    max = us;
+  total += us;
+}
+
+unsigned
+TimingHistogram::GetPercentile(unsigned percent) const
+{
+  if (count == 0)
+    return 0;
+
+  /* the rank of the requested sample, rounded up */
+  const unsigned long long rank =
+    ((unsigned long long)count * percent + 99) / 100;
+
+  unsigned long long sum = 0;
+  for (unsigned i = 0; i < NUM_BUCKETS; ++i) {
+    sum += buckets[i];
+    if (sum >= rank && sum > 0)
+      /* the last bucket collects all larger samples */
+      return i < NUM_BUCKETS - 1
+        ? std::min((2u << i) - 1, max)
+        : max;
+  }
+
+  return max;
+}
+
+StageProfiler::StageProfiler(const TCHAR *const *_names, unsigned _num_stages)
+  :names(_names), num_stages(_num_stages), enabled(false)
+{
+  assert(num_stages <= MAX_STAGES);
+}
+
+void
+StageProfiler::Add(unsigned stage, unsigned us)
+{
+  assert(stage < num_stages);
+
+  ScopeLock protect(mutex);
+  histograms[stage].Add(us);
+}
+
+void
+StageProfiler::Reset()
+{
+  ScopeLock protect(mutex);
+  for (unsigned i = 0; i < num_stages; ++i)
+    histograms[i].Reset();
+}
+
+TimingHistogram
+StageProfiler::Get(unsigned stage) const
+{
+  assert(stage < num_stages);
+
+  ScopeLock protect(mutex);
+  return histograms[stage];
+}
+
+void
+StageProfiler::Dump() const
+{
+  LogStartUp(_T("Stage profile (us): name count mean p50 p95 p99 max"));
+
+  for (unsigned i = 0; i < num_stages; ++i) {
+    const TimingHistogram h = Get(i);
+    if (h.GetCount() == 0)
+      continue;
+
+    LogStartUp(_T("  %-16s %u %u %u %u %u %u"), names[i],
+               h.GetCount(), h.GetMean(),
+               h.GetPercentile(50), h.GetPercentile(95),
+               h.GetPercentile(99), h.GetMax());
+  }
+}
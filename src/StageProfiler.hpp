@@ -0,0 +1,173 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_STAGE_PROFILER_HPP
+#define XCSOAR_STAGE_PROFILER_HPP
+
+#include "Thread/Mutex.hpp"
+#include "OS/Clock.hpp"
+#include "Compiler.h"
+
+#include <assert.h>
+#include <tchar.h>
+
+/**
+ * A compact histogram of durations in microseconds.  Samples are
+ * sorted into power-of-two buckets, which is precise enough to
+ * estimate percentiles and cheap enough to update on every tick.
+ */
+class TimingHistogram {
+public:
+  enum {
+    NUM_BUCKETS = 24,
+  };
+
+private:
+  unsigned buckets[NUM_BUCKETS];
+  unsigned count;
+  unsigned last, max;
+  unsigned long long total;
+
+public:
+  TimingHistogram() {
+    Reset();
+  }
+
+  void Reset();
+
+  void Add(unsigned us);
+
+  unsigned GetCount() const {
+    return count;
+  }
+
+  /**
+   * Returns the most recent sample.
+   */
+  unsigned GetLast() const {
+    return last;
+  }
+
+  unsigned GetMax() const {
+    return max;
+  }
+
+  gcc_pure
+  unsigned GetMean() const {
+    return count > 0 ? (unsigned)(total / count) : 0;
+  }
+
+  /**
+   * Estimates the given percentile (0..100) from the buckets.  The
+   * result is the upper bound of the bucket the percentile falls
+   * into, but never more than the largest sample.
+   */
+  gcc_pure
+  unsigned GetPercentile(unsigned percent) const;
+};
+
+/**
+ * Collects one #TimingHistogram per stage of a processing pipeline.
+ * The instrumentation is always compiled, but timers only read the
+ * clock while the profiler is enabled, so the cost of a disabled
+ * profiler is one flag check per stage.
+ */
+class StageProfiler : private NonCopyable {
+public:
+  enum {
+    MAX_STAGES = 24,
+  };
+
+private:
+  const TCHAR *const *names;
+  unsigned num_stages;
+
+  bool enabled;
+
+  mutable Mutex mutex;
+  TimingHistogram histograms[MAX_STAGES];
+
+public:
+  /**
+   * @param names a static array of stage names
+   */
+  StageProfiler(const TCHAR *const *_names, unsigned _num_stages);
+
+  bool IsEnabled() const {
+    return enabled;
+  }
+
+  void SetEnabled(bool _enabled) {
+    enabled = _enabled;
+  }
+
+  unsigned GetNumStages() const {
+    return num_stages;
+  }
+
+  const TCHAR *GetName(unsigned stage) const {
+    assert(stage < num_stages);
+
+    return names[stage];
+  }
+
+  void Add(unsigned stage, unsigned us);
+
+  /**
+   * Clears all histograms.
+   */
+  void Reset();
+
+  /**
+   * Returns a copy of one stage's histogram.
+   */
+  TimingHistogram Get(unsigned stage) const;
+
+  /**
+   * Writes a table of all stages to the log file.
+   */
+  void Dump() const;
+};
+
+/**
+ * Measures the lifetime of this object and adds it to a stage of a
+ * #StageProfiler.
+ */
+class ScopeStageTimer {
+  StageProfiler &profiler;
+  unsigned stage;
+  bool active;
+  unsigned start;
+
+public:
+  ScopeStageTimer(StageProfiler &_profiler, unsigned _stage)
+    :profiler(_profiler), stage(_stage), active(_profiler.IsEnabled()),
+     start(active ? MonotonicClockUS() : 0) {}
+
+  ~ScopeStageTimer() {
+    if (active)
+      profiler.Add(stage, MonotonicClockUS() - start);
+  }
+};
+
+#endif
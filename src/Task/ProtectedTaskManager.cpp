@@ -390,6 +390,26 @@ ProtectedTaskManager::find_positive_arrival(const AGeoPoint& dest,
   return m_route.find_positive_arrival(dest, arrival_height_reach, arrival_height_direct);
 }
 
+unsigned
+ProtectedTaskManager::find_positive_arrivals(ReachQuery *queries,
+                                             unsigned n) const
+{
+  Lease lease(*this);
+  for (ReachQuery *q = queries, *end = queries + n; q != end; ++q)
+    m_route.find_positive_arrival(AGeoPoint(q->location, q->altitude),
+                                  q->arrival_height_reach,
+                                  q->arrival_height_direct);
+
+  return m_route.get_reach_serial();
+}
+
+unsigned
+ProtectedTaskManager::get_reach_serial() const
+{
+  Lease lease(*this);
+  return m_route.get_reach_serial();
+}
+
 void
 ProtectedTaskManager::accept_in_range(const GeoBounds& bounds,
                                       TriangleFanVisitor& visitor) const
@@ -47,6 +47,18 @@ private:
   const RoutePlannerGlue *route;
 };
 
+/**
+ * One destination of a batched reach query, see
+ * ProtectedTaskManager::find_positive_arrivals().
+ */
+struct ReachQuery {
+  GeoPoint location;
+  short altitude;
+
+  short arrival_height_reach;
+  short arrival_height_direct;
+};
+
 /**
  * Facade to task/airspace/waypoints as used by threads,
  * to manage locking
@@ -268,6 +280,20 @@ public:
                              short& arrival_height_reach,
                              short& arrival_height_direct) const;
 
+  /**
+   * Like find_positive_arrival(), but evaluates a whole list of
+   * destinations while holding the lock only once.
+   *
+   * @return the reach serial the results belong to
+   */
+  unsigned find_positive_arrivals(ReachQuery *queries, unsigned n) const;
+
+  /**
+   * @see RoutePlanner::get_reach_serial()
+   */
+  gcc_pure
+  unsigned get_reach_serial() const;
+
   short get_terrain_base() const;
 };
 
@@ -22,16 +22,87 @@
 
 #include "RoutePlannerGlue.hpp"
 #include "Thread/Guard.hpp"
+#include "Thread/Thread.hpp"
 #include "Terrain/RasterTerrain.hpp"
 #include "Navigation/SpeedVector.hpp"
 #include "NMEA/Derived.hpp"
+#include <algorithm>
 #include <assert.h>
 
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#endif
+
+/** the maximum number of threads started by ThreadRunner::ForEach() */
+static const unsigned MAX_RUNNER_WORKERS = 3;
+
+/**
+ * The jobs of one ThreadRunner::ForEach() call.  Each thread takes
+ * the next index until all are done.
+ */
+struct RunnerBatch {
+  ParallelRunner::Job &job;
+  const unsigned n;
+  unsigned next;
+
+  RunnerBatch(ParallelRunner::Job &_job, unsigned _n)
+    :job(_job), n(_n), next(0) {}
+
+  void Work() {
+    unsigned i;
+    while ((i = __sync_fetch_and_add(&next, 1)) < n)
+      job.Run(i);
+  }
+};
+
+class RunnerThread : public Thread {
+public:
+  RunnerBatch *batch;
+
+protected:
+  virtual void Run() {
+    batch->Work();
+  }
+};
+
+ThreadRunner::ThreadRunner()
+  :n_workers(0)
+{
+#ifdef HAVE_POSIX
+  const long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n > 1)
+    n_workers = std::min((unsigned)n - 1, MAX_RUNNER_WORKERS);
+#endif
+}
+
+void
+ThreadRunner::ForEach(Job &job, unsigned n)
+{
+  RunnerBatch batch(job, n);
+
+  RunnerThread threads[MAX_RUNNER_WORKERS];
+  unsigned n_started = 0;
+  for (; n_started < n_workers && n_started + 1 < n; ++n_started) {
+    threads[n_started].batch = &batch;
+    /* if a thread cannot be started, the others and this one take
+       over its share */
+    if (!threads[n_started].Start())
+      break;
+  }
+
+  batch.Work();
+
+  for (unsigned i = 0; i < n_started; ++i)
+    threads[i].Join();
+}
+
 RoutePlannerGlue::RoutePlannerGlue(const GlidePolar& polar,
                                    const Airspaces& master):
   terrain(NULL),
   m_planner(polar, SpeedVector(Angle::degrees(fixed_zero), fixed_zero), master)
 {
+  if (reach_runner.IsParallel())
+    m_planner.set_reach_runner(&reach_runner);
 }
 
 void
@@ -26,9 +26,31 @@
 
 class RasterTerrain;
 
+/**
+ * Runs the jobs of ForEach() on a few short-lived threads and on the
+ * calling thread.  Used to trace the rays of the reach fan.
+ */
+class ThreadRunner : public ParallelRunner {
+  /** the number of threads started in addition to the caller */
+  unsigned n_workers;
+
+public:
+  ThreadRunner();
+
+  /**
+   * Are there other processors to run jobs on?
+   */
+  bool IsParallel() const {
+    return n_workers > 0;
+  }
+
+  virtual void ForEach(Job &job, unsigned n);
+};
+
 class RoutePlannerGlue {
   const RasterTerrain *terrain;
   AirspaceRoute m_planner;
+  ThreadRunner reach_runner;
 
 public:
   RoutePlannerGlue(const GlidePolar& polar,
@@ -74,6 +96,10 @@ public:
 
   GlidePolar get_reach_polar() const;
 
+  unsigned get_reach_serial() const {
+    return m_planner.get_reach_serial();
+  }
+
   short get_terrain_base() const;
 };
 
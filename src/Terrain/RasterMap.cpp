@@ -94,6 +94,29 @@ RasterMap::SetViewCenter(const GeoPoint &location, fixed radius)
                                 projection.distance_pixels(radius) / 256);
 }
 
+/**
+ * Converts a sub-pixel coordinate which may be left of or above the
+ * raster to a pixel coordinate.
+ */
+gcc_const
+static unsigned
+ClipPixel(unsigned coordinate)
+{
+  return (int)coordinate > 0 ? coordinate >> 8 : 0;
+}
+
+unsigned
+RasterMap::GetSerial(const GeoBounds &bounds) const
+{
+  const RasterLocation nw =
+    projection.project(GeoPoint(bounds.west, bounds.north));
+  const RasterLocation se =
+    projection.project(GeoPoint(bounds.east, bounds.south));
+
+  return raster_tile_cache.GetSerial(ClipPixel(nw.x), ClipPixel(nw.y),
+                                     ClipPixel(se.x), ClipPixel(se.y));
+}
+
 short
 RasterMap::GetHeight(const GeoPoint &location) const
 {
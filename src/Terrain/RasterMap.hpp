@@ -70,6 +70,23 @@ public:
     return raster_tile_cache.IsDirty();
   }
 
+  /**
+   * @see RasterTileCache::GetSerial()
+   */
+  gcc_pure
+  unsigned GetSerial() const {
+    return raster_tile_cache.GetSerial();
+  }
+
+  /**
+   * Returns the serial of the last change affecting heights within
+   * the specified area.
+   *
+   * @see RasterTileCache::GetSerial()
+   */
+  gcc_pure
+  unsigned GetSerial(const GeoBounds &bounds) const;
+
   /**
    * @see RasterProjection::pixel_distance()
    */
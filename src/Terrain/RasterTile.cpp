@@ -200,6 +200,8 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
     /* dispose all tiles which are out of range */
     for (unsigned i = MAX_ACTIVE_TILES; i < RequestTiles.size(); ++i) {
       RasterTile &tile = tiles.GetLinear(RequestTiles[i]);
+      if (tile.IsEnabled())
+        tile.serial = ++serial;
       tile.Disable();
     }
 
@@ -236,9 +238,27 @@ RasterTileCache::TileRequest(unsigned index)
     return false;
 
   tile.Enable();
+  tile.serial = ++serial;
   return true; // want to load this one!
 }
 
+unsigned
+RasterTileCache::GetSerial(unsigned x0, unsigned y0,
+                           unsigned x1, unsigned y1) const
+{
+  unsigned result = reset_serial;
+
+  for (unsigned i = 0, n = tiles.GetSize(); i < n; ++i) {
+    const RasterTile &tile = tiles.GetLinear(i);
+    if (tile.serial > result &&
+        tile.xstart <= x1 && tile.xend > x0 &&
+        tile.ystart <= y1 && tile.yend > y0)
+      result = tile.serial;
+  }
+
+  return result;
+}
+
 short
 RasterTileCache::GetHeight(unsigned px, unsigned py) const
 {
@@ -312,6 +332,7 @@ RasterTileCache::Reset()
   bounds_initialised = false;
   segments.clear();
   scan_overview = true;
+  reset_serial = ++serial;
 
   Overview.reset();
 
@@ -56,12 +56,18 @@ public:
 
   bool request;
 
+  /**
+   * The RasterTileCache serial of the last time this tile was loaded
+   * or discarded.
+   */
+  unsigned serial;
+
   RasterBuffer buffer;
 
 public:
   RasterTile()
     :xstart(0), ystart(0), xend(0), yend(0),
-     width(0), height(0) {}
+     width(0), height(0), serial(0) {}
 
   void set(unsigned _xstart, unsigned _ystart,
            unsigned _xend, unsigned _yend) {
@@ -238,6 +244,15 @@ protected:
 
   bool dirty;
 
+  /**
+   * Incremented each time the set of loaded tiles changes, i.e. when
+   * the heights returned for a location may differ from before.
+   */
+  unsigned serial;
+
+  /** The value of #serial after the last Reset() */
+  unsigned reset_serial;
+
   AllocatedGrid<RasterTile> tiles;
   unsigned short tile_width, tile_height;
 
@@ -263,7 +278,7 @@ protected:
   OperationEnvironment *operation;
 
 public:
-  RasterTileCache():operation(NULL) {
+  RasterTileCache():serial(0), reset_serial(0), operation(NULL) {
     Reset();
   }
 
@@ -355,6 +370,24 @@ public:
     return initialised;
   }
 
+  /**
+   * Returns a number which changes whenever terrain heights may have
+   * changed.  This allows callers to keep results of terrain queries
+   * until new tiles are loaded or discarded.
+   */
+  unsigned GetSerial() const {
+    return serial;
+  }
+
+  /**
+   * Like GetSerial(), but only considers changes of the tiles
+   * overlapping the specified pixel rectangle (inclusive).  The
+   * result is never greater than GetSerial().
+   */
+  gcc_pure
+  unsigned GetSerial(unsigned x0, unsigned y0,
+                     unsigned x1, unsigned y1) const;
+
   void Reset();
 
   const GeoBounds &GetBounds() const {
@@ -90,6 +90,13 @@ public:
   void Signal() {
     pthread_cond_signal(&cond);
   }
+
+  /**
+   * Wakes up all threads waiting for this object.
+   */
+  void Broadcast() {
+    pthread_cond_broadcast(&cond);
+  }
 };
 
 #endif
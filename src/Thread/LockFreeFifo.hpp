@@ -0,0 +1,137 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_LOCK_FREE_FIFO_HPP
+#define XCSOAR_THREAD_LOCK_FREE_FIFO_HPP
+
+#include "Util/NonCopyable.hpp"
+
+#include <assert.h>
+#include <stddef.h>
+
+#if !defined(__GNUC__) && defined(_MSC_VER)
+#include <windows.h>
+#endif
+
+/**
+ * Orders all memory accesses before and after this call.
+ */
+static inline void
+full_memory_barrier()
+{
+#ifdef __GNUC__
+  __sync_synchronize();
+#elif defined(_MSC_VER)
+  MemoryBarrier();
+#else
+#error No memory barrier available
+#endif
+}
+
+/**
+ * A fixed-size first-in-first-out ring buffer which may be used by
+ * exactly one producer thread and one consumer thread without a
+ * lock.  It stores up to "size-1" items (for the full/empty
+ * distinction).
+ *
+ * The producer calls write() and append(), the consumer calls read(),
+ * consume() and clear().  If more than one thread acts as consumer,
+ * they must serialise with their own lock.
+ */
+template<class T, unsigned size>
+class LockFreeFifo : private NonCopyable {
+  T data[size];
+
+  /** the next item to be read; modified only by the consumer */
+  volatile unsigned head;
+
+  /** the next item to be written; modified only by the producer */
+  volatile unsigned tail;
+
+  static unsigned next(unsigned i) {
+    return (i + 1) % size;
+  }
+
+public:
+  LockFreeFifo():head(0), tail(0) {}
+
+  /**
+   * Returns the slot to be filled by the producer, or NULL if the
+   * buffer is full.  When finished, call append().
+   */
+  T *write() {
+    const unsigned t = tail;
+    if (next(t) == head)
+      return NULL;
+
+    return &data[t];
+  }
+
+  /**
+   * Publishes the slot returned by write() to the consumer.
+   */
+  void append() {
+    const unsigned t = tail;
+    assert(next(t) != head);
+
+    /* the item must be complete before the consumer sees it */
+    full_memory_barrier();
+    tail = next(t);
+  }
+
+  /**
+   * Returns the oldest item, or NULL if the buffer is empty.  When
+   * finished, call consume().
+   */
+  T *read() {
+    const unsigned h = head;
+    if (h == tail)
+      return NULL;
+
+    /* don't read the item before the producer's "tail" update */
+    full_memory_barrier();
+    return &data[h];
+  }
+
+  /**
+   * Releases the item returned by read() to the producer.
+   */
+  void consume() {
+    const unsigned h = head;
+    assert(h != tail);
+
+    /* finish reading the item before the producer may overwrite it */
+    full_memory_barrier();
+    head = next(h);
+  }
+
+  /**
+   * Discards all items.  Must be called by the consumer.
+   */
+  void clear() {
+    full_memory_barrier();
+    head = tail;
+  }
+};
+
+#endif
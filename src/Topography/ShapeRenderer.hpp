@@ -32,6 +32,7 @@ Copyright_License {
 #include "Util/AllocatedArray.hpp"
 #include "Screen/Canvas.hpp"
 #include "Screen/Brush.hpp"
+#include "Projection.hpp"
 
 #include <assert.h>
 
@@ -79,6 +80,23 @@ public:
       add_point(pt);
   }
 
+  /**
+   * Projects the GeoPoints to the screen, and adds each one which is
+   * a few pixels distant from the previous one.
+   */
+  void add_points_if_distant(const Projection &projection,
+                             const GeoPoint *src, unsigned n) {
+    assert(num_points + n <= points.size());
+
+    /* project into the free tail of the array, and then compact it
+       in-place; the write position never passes the read position */
+    RasterPoint *tail = points.begin() + num_points;
+    projection.GeoToScreen(src, tail, n);
+
+    for (unsigned i = 0; i < n; ++i)
+      add_point_if_distant(tail[i]);
+  }
+
   void finish_polyline(Canvas &canvas) {
     if (mode != OUTLINE) {
       canvas.select(*pen);
@@ -186,9 +186,8 @@ TopographyFileRenderer::Paint(Canvas &canvas,
         unsigned msize = *lines;
         shape_renderer.begin_shape(msize);
 
-        const GeoPoint *end = points + msize - 1;
-        for (; points < end; ++points)
-          shape_renderer.add_point_if_distant(projection.GeoToScreen(*points));
+        shape_renderer.add_points_if_distant(projection, points, msize - 1);
+        points += msize - 1;
 
         // make sure we always draw the last point
         shape_renderer.add_point(projection.GeoToScreen(*points));
@@ -234,10 +233,8 @@ TopographyFileRenderer::Paint(Canvas &canvas,
 
         shape_renderer.begin_shape(msize);
 
-        for (unsigned i = 0; i < msize; ++i) {
-          GeoPoint g = geo_points[i];
-          shape_renderer.add_point_if_distant(projection.GeoToScreen(g));
-        }
+        shape_renderer.add_points_if_distant(projection, geo_points.begin(),
+                                             msize);
 
         shape_renderer.finish_polygon(canvas);
       }
@@ -0,0 +1,71 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_GENERATION_HPP
+#define XCSOAR_GENERATION_HPP
+
+#if !defined(__GNUC__) && defined(_MSC_VER)
+#include <windows.h>
+#endif
+
+/**
+ * Identifies one version of a data section.  Every call to Modified()
+ * draws a new value from a process-wide counter, so two sections
+ * carrying the same Generation are known to hold the same data, and
+ * an assignment between them may be skipped.
+ */
+class Generation {
+  unsigned value;
+
+public:
+  Generation():value(Next()) {}
+
+  /**
+   * Must be called by every method which modifies the section.
+   */
+  void Modified() {
+    value = Next();
+  }
+
+  bool operator==(const Generation &other) const {
+    return value == other.value;
+  }
+
+  bool operator!=(const Generation &other) const {
+    return value != other.value;
+  }
+
+private:
+  static unsigned Next() {
+    static volatile long counter;
+#ifdef __GNUC__
+    return (unsigned)__sync_add_and_fetch(&counter, 1);
+#elif defined(_MSC_VER)
+    return (unsigned)InterlockedIncrement(&counter);
+#else
+#error No atomic increment available
+#endif
+  }
+};
+
+#endif
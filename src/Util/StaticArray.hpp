@@ -51,6 +51,22 @@ protected:
 public:
   StaticArray():the_size(0) {}
 
+  /**
+   * Copies only the allocated elements, not the whole buffer.
+   */
+  StaticArray(const StaticArray &other):the_size(other.the_size) {
+    std::copy(other.begin(), other.end(), data);
+  }
+
+  StaticArray &operator=(const StaticArray &other) {
+    if (this != &other) {
+      the_size = other.the_size;
+      std::copy(other.begin(), other.end(), data);
+    }
+
+    return *this;
+  }
+
   size_type capacity() const { return max; }
 
   /**
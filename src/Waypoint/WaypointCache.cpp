@@ -0,0 +1,167 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "WaypointCache.hpp"
+#include "Waypoint/Waypoints.hpp"
+
+#include <algorithm>
+#include <vector>
+#include <stdint.h>
+
+struct CacheHeader {
+  static const unsigned VERSION = 1;
+
+  unsigned version;
+
+  /** sizeof(CacheRecord) and sizeof(TCHAR) of the writer */
+  uint16_t record_size, char_size;
+
+  unsigned num_waypoints;
+};
+
+/**
+ * The fixed size part of a waypoint, followed by the three strings.
+ */
+struct CacheRecord {
+  unsigned original_id;
+  GeoPoint location;
+  fixed altitude;
+  Runway runway;
+  RadioFrequency radio_frequency;
+  uint8_t type;
+  struct Waypoint::Flags flags;
+};
+
+static bool
+SaveString(FILE *file, const tstring &value)
+{
+  const unsigned length = value.length();
+  return fwrite(&length, sizeof(length), 1, file) == 1 &&
+    fwrite(value.data(), sizeof(TCHAR), length, file) == length;
+}
+
+static bool
+LoadString(FILE *file, tstring &value)
+{
+  unsigned length;
+  if (fread(&length, sizeof(length), 1, file) != 1 || length > 0x10000)
+    return false;
+
+  value.resize(length);
+  return length == 0 ||
+    fread(&value[0], sizeof(TCHAR), length, file) == length;
+}
+
+static bool
+CompareId(const Waypoint *a, const Waypoint *b)
+{
+  return a->id < b->id;
+}
+
+bool
+WaypointCache::Save(FILE *file, const Waypoints &way_points, int file_num)
+{
+  /* the ids are assigned in parsing order; keep it, so the waypoints
+     get the same ids when they are loaded from the cache */
+  std::vector<const Waypoint *> list;
+  for (Waypoints::const_iterator i = way_points.begin();
+       i != way_points.end(); ++i)
+    if (i->FileNum == file_num)
+      list.push_back(&*i);
+
+  std::sort(list.begin(), list.end(), CompareId);
+
+  CacheHeader header;
+  header.version = CacheHeader::VERSION;
+  header.record_size = sizeof(CacheRecord);
+  header.char_size = sizeof(TCHAR);
+  header.num_waypoints = list.size();
+  if (fwrite(&header, sizeof(header), 1, file) != 1)
+    return false;
+
+  for (std::vector<const Waypoint *>::const_iterator i = list.begin();
+       i != list.end(); ++i) {
+    const Waypoint &wp = **i;
+
+    CacheRecord record;
+    record.original_id = wp.original_id;
+    record.location = wp.Location;
+    record.altitude = wp.Altitude;
+    record.runway = wp.runway;
+    record.radio_frequency = wp.radio_frequency;
+    record.type = wp.Type;
+    record.flags = wp.Flags;
+
+    if (fwrite(&record, sizeof(record), 1, file) != 1 ||
+        !SaveString(file, wp.Name) ||
+        !SaveString(file, wp.Comment) ||
+        !SaveString(file, wp.Details))
+      return false;
+  }
+
+  return true;
+}
+
+bool
+WaypointCache::Load(FILE *file, Waypoints &way_points, int file_num)
+{
+  CacheHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      header.version != CacheHeader::VERSION ||
+      header.record_size != sizeof(CacheRecord) ||
+      header.char_size != sizeof(TCHAR))
+    return false;
+
+  /* read everything before appending, so a truncated file does not
+     leave half of the waypoints behind */
+  std::vector<Waypoint> list;
+  list.reserve(std::min(header.num_waypoints, 0x100000u));
+
+  for (unsigned n = 0; n < header.num_waypoints; ++n) {
+    CacheRecord record;
+    if (fread(&record, sizeof(record), 1, file) != 1)
+      return false;
+
+    Waypoint wp(record.location);
+    wp.original_id = record.original_id;
+    wp.Altitude = record.altitude;
+    wp.runway = record.runway;
+    wp.radio_frequency = record.radio_frequency;
+    wp.Type = (enum Waypoint::Type)record.type;
+    wp.Flags = record.flags;
+    wp.FileNum = file_num;
+
+    if (!LoadString(file, wp.Name) ||
+        !LoadString(file, wp.Comment) ||
+        !LoadString(file, wp.Details))
+      return false;
+
+    list.push_back(wp);
+  }
+
+  for (std::vector<Waypoint>::const_iterator i = list.begin();
+       i != list.end(); ++i)
+    way_points.append(*i);
+
+  return true;
+}
@@ -147,7 +147,7 @@ WaypointGlue::SetHome(Waypoints &way_points, const RasterTerrain *terrain,
 
 bool
 WaypointGlue::LoadWaypointFile(int num, Waypoints &way_points,
-                               const RasterTerrain *terrain,
+                               const RasterTerrain *terrain, FileCache *cache,
                                OperationEnvironment &operation)
 {
   // Get waypoint filename
@@ -161,6 +161,7 @@ WaypointGlue::LoadWaypointFile(int num, Waypoints &way_points,
   if (!reader.Error()) {
     // parse the file
     reader.SetTerrain(terrain);
+    reader.SetCache(cache);
 
     if (reader.Parse(way_points, operation))
       return true;
@@ -177,6 +178,7 @@ bool
 WaypointGlue::LoadMapFileWaypoints(int num, const TCHAR* key,
                                    Waypoints &way_points,
                                    const RasterTerrain *terrain,
+                                   FileCache *cache,
                                    OperationEnvironment &operation)
 {
   TCHAR szFile[MAX_PATH];
@@ -202,6 +204,7 @@ WaypointGlue::LoadMapFileWaypoints(int num, const TCHAR* key,
   if (!reader.Error()) {
     // parse the file
     reader.SetTerrain(terrain);
+    reader.SetCache(cache);
     if (reader.Parse(way_points, operation))
       return true;
 
@@ -215,7 +218,7 @@ WaypointGlue::LoadMapFileWaypoints(int num, const TCHAR* key,
 
 bool
 WaypointGlue::LoadWaypoints(Waypoints &way_points,
-                            const RasterTerrain *terrain,
+                            const RasterTerrain *terrain, FileCache *cache,
                             OperationEnvironment &operation)
 {
   LogStartUp(_T("ReadWaypoints"));
@@ -227,20 +230,20 @@ WaypointGlue::LoadWaypoints(Waypoints &way_points,
   way_points.clear();
 
   // ### FIRST FILE ###
-  found |= LoadWaypointFile(1, way_points, terrain, operation);
+  found |= LoadWaypointFile(1, way_points, terrain, cache, operation);
 
   // ### SECOND FILE ###
-  found |= LoadWaypointFile(2, way_points, terrain, operation);
+  found |= LoadWaypointFile(2, way_points, terrain, cache, operation);
 
   // ### WATCHED WAYPOINT/THIRD FILE ###
-  found |= LoadWaypointFile(3, way_points, terrain, operation);
+  found |= LoadWaypointFile(3, way_points, terrain, cache, operation);
 
   // ### MAP/FOURTH FILE ###
 
   // If no waypoint file found yet
   if (!found)
     found = LoadMapFileWaypoints(0, szProfileMapFile, way_points, terrain,
-                                 operation);
+                                 cache, operation);
 
   // Optimise the waypoint list after attaching new waypoints
   way_points.optimise();
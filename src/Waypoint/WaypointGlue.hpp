@@ -29,6 +29,7 @@ Copyright_License {
 class Waypoints;
 class RasterTerrain;
 class OperationEnvironment;
+class FileCache;
 struct SETTINGS_COMPUTER;
 
 class WaypointReaderBase;
@@ -45,15 +46,17 @@ namespace WaypointGlue {
    * specified waypoint list
    * @param way_points The waypoint list to fill
    * @param terrain RasterTerrain (for automatic waypoint height)
+   * @param cache a cache for parsed waypoint files (may be NULL)
    */
   bool LoadWaypoints(Waypoints &way_points,
-                     const RasterTerrain *terrain,
+                     const RasterTerrain *terrain, FileCache *cache,
                      OperationEnvironment &operation);
   bool LoadWaypointFile(int num, Waypoints &way_points,
-                        const RasterTerrain *terrain,
+                        const RasterTerrain *terrain, FileCache *cache,
                         OperationEnvironment &operation);
   bool LoadMapFileWaypoints(int num, const TCHAR* key,
                             Waypoints &way_points, const RasterTerrain *terrain,
+                            FileCache *cache,
                             OperationEnvironment &operation);
   bool SaveWaypoints(const Waypoints &way_points);
   bool SaveWaypointFile(const Waypoints &way_points, int num);
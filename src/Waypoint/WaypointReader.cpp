@@ -51,6 +51,13 @@ WaypointReader::SetTerrain(const RasterTerrain* _terrain)
     reader->SetTerrain(_terrain);
 }
 
+void
+WaypointReader::SetCache(FileCache *cache)
+{
+  if (reader != NULL)
+    reader->SetCache(cache);
+}
+
 void
 WaypointReader::Open(const TCHAR* filename, int the_filenum)
 {
@@ -32,6 +32,7 @@ Copyright_License {
 class Waypoints;
 class RasterTerrain;
 class OperationEnvironment;
+class FileCache;
 
 class WaypointReader
 {
@@ -57,6 +58,12 @@ public:
   /** Sets the terrain that should be used for waypoint elevation detection */
   void SetTerrain(const RasterTerrain* _terrain);
 
+  /**
+   * Sets the cache for binary snapshots of the parsed waypoints.
+   * May be NULL to disable caching.
+   */
+  void SetCache(FileCache *cache);
+
   /**
    * Parses the waypoint file into the given Waypoints instance
    * @param way_points A Waypoints instance that will hold the parsed waypoints
@@ -22,21 +22,26 @@ Copyright_License {
 */
 
 #include "WaypointReaderBase.hpp"
+#include "WaypointCache.hpp"
 
 #include "Terrain/RasterTerrain.hpp"
 #include "Waypoint/Waypoint.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "IO/FileLineReader.hpp"
 #include "IO/ZipLineReader.hpp"
+#include "IO/FileCache.hpp"
 #include "Operation.hpp"
 
 #include <assert.h>
+#include <stdio.h>
 
 WaypointReaderBase::WaypointReaderBase(const TCHAR* file_name, const int _file_num,
                            bool _compressed):
   file_num(_file_num),
   terrain(NULL),
-  compressed(_compressed)
+  cache(NULL),
+  compressed(_compressed),
+  altitude_missing(false)
 {
   _tcscpy(file, file_name);
 }
@@ -140,8 +145,10 @@ WaypointReaderBase::ExtractParameters(const TCHAR *src, TCHAR *dst,
 }
 
 void
-WaypointReaderBase::CheckAltitude(Waypoint &new_waypoint) const
+WaypointReaderBase::CheckAltitude(Waypoint &new_waypoint)
 {
+  altitude_missing = true;
+
   if (terrain == NULL)
     return;
 
@@ -172,6 +179,31 @@ WaypointReaderBase::Parse(Waypoints &way_points, TLineReader &reader,
   }
 }
 
+bool
+WaypointReaderBase::LoadCache(Waypoints &way_points, const TCHAR *name)
+{
+  FILE *cache_file = cache->load(name, file);
+  if (cache_file == NULL)
+    return false;
+
+  bool success = WaypointCache::Load(cache_file, way_points, file_num);
+  fclose(cache_file);
+  return success;
+}
+
+void
+WaypointReaderBase::SaveCache(const Waypoints &way_points, const TCHAR *name)
+{
+  FILE *cache_file = cache->save(name, file);
+  if (cache_file == NULL)
+    return;
+
+  if (WaypointCache::Save(cache_file, way_points, file_num))
+    cache->commit(name, cache_file);
+  else
+    cache->cancel(name, cache_file);
+}
+
 bool
 WaypointReaderBase::Parse(Waypoints &way_points,
                           OperationEnvironment &operation)
@@ -180,6 +212,29 @@ WaypointReaderBase::Parse(Waypoints &way_points,
   if (file[0] == 0)
     return false;
 
+  if (cache == NULL)
+    return ParseFile(way_points, operation);
+
+  TCHAR name[32];
+  _stprintf(name, _T("waypoints%d"), file_num);
+
+  if (LoadCache(way_points, name))
+    return true;
+
+  altitude_missing = false;
+  if (!ParseFile(way_points, operation))
+    return false;
+
+  if (!altitude_missing)
+    SaveCache(way_points, name);
+
+  return true;
+}
+
+bool
+WaypointReaderBase::ParseFile(Waypoints &way_points,
+                              OperationEnvironment &operation)
+{
   if (!compressed) {
     // Try to open waypoint file
     FileLineReader reader(file);
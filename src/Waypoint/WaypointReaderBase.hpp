@@ -32,6 +32,7 @@ class Waypoints;
 class RasterTerrain;
 class TLineReader;
 class OperationEnvironment;
+class FileCache;
 
 class WaypointReaderBase 
 {
@@ -39,8 +40,15 @@ protected:
   TCHAR file[255];
   const int file_num;
   const RasterTerrain* terrain;
+  FileCache *cache;
   bool compressed;
 
+  /**
+   * Was the altitude of a waypoint missing in the file?  If yes, the
+   * waypoints depend on the terrain and cannot be cached.
+   */
+  bool altitude_missing;
+
 protected:
   WaypointReaderBase(const TCHAR* file_name, const int _file_num,
                bool _compressed = false);
@@ -51,7 +59,10 @@ public:
   typedef void (*StatusCallback)(unsigned percent);
 
   /**
-   * Parses the waypoint file provided by SetFile() into the given waypoint list
+   * Parses the waypoint file provided by SetFile() into the given
+   * waypoint list.  If a #FileCache was set, the waypoints are loaded
+   * from a cached snapshot if the file has not changed since, or a
+   * new snapshot is saved after parsing.
    * @param way_points The waypoint list to fill
    * @param terrain RasterTerrain (for automatic waypoint height)
    * @return True if the waypoint file parsing was okay, False otherwise
@@ -69,8 +80,17 @@ public:
     terrain = _terrain;
   }
 
+  void SetCache(FileCache *_cache) {
+    cache = _cache;
+  }
+
 protected:
-  void CheckAltitude(Waypoint &new_waypoint) const;
+  void CheckAltitude(Waypoint &new_waypoint);
+
+private:
+  bool ParseFile(Waypoints &way_points, OperationEnvironment &operation);
+  bool LoadCache(Waypoints &way_points, const TCHAR *name);
+  void SaveCache(const Waypoints &way_points, const TCHAR *name);
 
   /**
    * Parse a file line
@@ -74,17 +74,19 @@ struct VisibleWaypoint {
     in_task = _in_task;
   }
 
-  void CalculateReachability(const ProtectedTaskManager &task,
-                             const TaskBehaviour &task_behaviour)
+  /**
+   * Returns the destination of the reach query for this waypoint.
+   */
+  short GetArrivalAltitude(const TaskBehaviour &task_behaviour) const {
+    return (short)(waypoint->Altitude + task_behaviour.safety_height_arrival);
+  }
+
+  void SetReachability(short _arrival_height_terrain,
+                       short _arrival_height_glide,
+                       const TaskBehaviour &task_behaviour)
   {
-    const fixed elevation = waypoint->Altitude +
-      task_behaviour.safety_height_arrival;
-    const AGeoPoint p_dest (waypoint->Location, elevation);
-    if (task.find_positive_arrival(p_dest, arrival_height_terrain, arrival_height_glide)) {
-      const short h_base = iround(elevation);
-      arrival_height_terrain -= h_base;
-      arrival_height_glide -= h_base;
-    }
+    arrival_height_terrain = _arrival_height_terrain;
+    arrival_height_glide = _arrival_height_glide;
 
     if (arrival_height_glide <= 0)
       reachable = WaypointRenderer::Unreachable;
@@ -353,13 +355,74 @@ public:
     task_valid = true;
   }
 
-  void Calculate(const ProtectedTaskManager &task) {
+  /**
+   * Looks up the arrival heights of all visible landables in the
+   * cache, and queries the ones which are missing in one batch.  The
+   * cache is flushed whenever the reach changes.
+   */
+  void Calculate(const ProtectedTaskManager &task,
+                 WaypointRenderer::ReachCache &cache, unsigned &cache_serial) {
+    const unsigned serial = task.get_reach_serial();
+    if (serial != cache_serial) {
+      cache.clear();
+      cache_serial = serial;
+    }
+
+    StaticArray<VisibleWaypoint *, 256> missing;
+    StaticArray<ReachQuery, 256> queries;
+
     for (unsigned i = 0; i < waypoints.size(); ++i) {
       VisibleWaypoint &vwp = waypoints[i];
       const Waypoint &way_point = *vwp.waypoint;
 
-      if (way_point.IsLandable() || way_point.Flags.Watched)
-        vwp.CalculateReachability(task, task_behaviour);
+      if (!way_point.IsLandable() && !way_point.Flags.Watched)
+        continue;
+
+      const short altitude = vwp.GetArrivalAltitude(task_behaviour);
+
+      WaypointRenderer::ReachCache::const_iterator it =
+        cache.find(way_point.id);
+      if (it != cache.end() && it->second.location == way_point.Location &&
+          it->second.altitude == altitude) {
+        vwp.SetReachability(it->second.arrival_height_terrain,
+                            it->second.arrival_height_glide,
+                            task_behaviour);
+        continue;
+      }
+
+      ReachQuery &query = queries.append();
+      query.location = way_point.Location;
+      query.altitude = altitude;
+      missing.append(&vwp);
+    }
+
+    if (queries.empty())
+      return;
+
+    const unsigned result_serial =
+      task.find_positive_arrivals(queries.begin(), queries.size());
+    if (result_serial != cache_serial) {
+      /* the reach was updated in the meantime; the new results
+         belong to the new one */
+      cache.clear();
+      cache_serial = result_serial;
+    }
+
+    for (unsigned i = 0; i < queries.size(); ++i) {
+      const ReachQuery &query = queries[i];
+      VisibleWaypoint &vwp = *missing[i];
+
+      const short h_base = iround(vwp.waypoint->Altitude +
+                                  task_behaviour.safety_height_arrival);
+
+      WaypointRenderer::ReachCacheItem &item = cache[vwp.waypoint->id];
+      item.location = query.location;
+      item.altitude = query.altitude;
+      item.arrival_height_terrain = query.arrival_height_reach - h_base;
+      item.arrival_height_glide = query.arrival_height_direct - h_base;
+
+      vwp.SetReachability(item.arrival_height_terrain,
+                          item.arrival_height_glide, task_behaviour);
     }
   }
 
@@ -416,7 +479,7 @@ WaypointRenderer::render(Canvas &canvas, LabelBlock &label_block,
     way_points->visit_within_range(projection.GetGeoScreenCenter(),
                                    projection.GetScreenDistanceMeters(), v);
 
-    v.Calculate(*task);
+    v.Calculate(*task, reach_cache, reach_serial);
     v.Draw(canvas);
 
     MapWaypointLabelRender(canvas,
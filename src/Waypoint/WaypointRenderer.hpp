@@ -28,6 +28,8 @@ Copyright_License {
 #include "Screen/Point.hpp"
 #include "Engine/Waypoint/Waypoint.hpp"
 
+#include <map>
+
 #include <stddef.h>
 
 struct SETTINGS_MAP;
@@ -56,12 +58,40 @@ public:
     ReachableTerrain,
   };
 
+  /**
+   * The arrival heights of one waypoint, as calculated for the reach
+   * identified by #reach_serial.
+   */
+  struct ReachCacheItem {
+    GeoPoint location;
+    short altitude;
+
+    short arrival_height_terrain;
+    short arrival_height_glide;
+  };
+
+  /**
+   * Maps waypoint ids to their cached arrival heights.
+   */
+  typedef std::map<unsigned, ReachCacheItem> ReachCache;
+
+private:
+  ReachCache reach_cache;
+
+  /**
+   * The RoutePlanner::get_reach_serial() value #reach_cache was
+   * filled with.
+   */
+  unsigned reach_serial;
+
+public:
   WaypointRenderer(const Waypoints *_way_points,
                    const WaypointLook &_look)
-    :way_points(_way_points), look(_look) {}
+    :way_points(_way_points), look(_look), reach_serial(0) {}
 
   void set_way_points(const Waypoints *_way_points) {
     way_points = _way_points;
+    reach_cache.clear();
   }
 
   void render(Canvas &canvas, LabelBlock &label_block,
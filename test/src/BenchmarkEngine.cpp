@@ -0,0 +1,455 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * A suite of deterministic benchmarks for the task engine.  Every
+ * benchmark seeds the random number generator with a fixed value and
+ * uses only the files in test/data, so two runs do exactly the same
+ * work.  The output has one line per benchmark:
+ *
+ *   NAME RUNS MEDIAN_US MIN_US RESULT
+ *
+ * RESULT is a checksum of the benchmark's output (e.g. the contest
+ * score or the number of nodes expanded), which shows whether a
+ * change to the engine altered the results as well as the timing.
+ * test/src/benchmark.pl compares this output with a baseline.
+ */
+
+#include "harness_airspace.hpp"
+#include "Route/AirspaceRoute.hpp"
+#include "Route/TerrainRoute.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "Navigation/SpeedVector.hpp"
+#include "Navigation/Geometry/GeoVector.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/TaskEvents.hpp"
+#include "Engine/Task/Tasks/ContestManager.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Replay/IGCParser.hpp"
+#include "IO/FileLineReader.hpp"
+#include "OS/PathName.hpp"
+#include "OS/Clock.hpp"
+#include "Compatibility/path.h"
+#include "Operation.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+  BENCHMARK_SEED = 42,
+  DEFAULT_RUNS = 7,
+};
+
+static RasterMap *terrain_map;
+static std::vector<AIRCRAFT_STATE> flight;
+
+/**
+ * Loads the IGC file into #flight, with the same state derivation as
+ * RunBatchAnalysis.
+ */
+static bool
+LoadFlight(const char *_path)
+{
+  PathName path(_path);
+  FileLineReaderA reader(path);
+  if (reader.error())
+    return false;
+
+  const GlidePolar glide_polar(fixed_zero);
+
+  AIRCRAFT_STATE state, last;
+  bool last_valid = false;
+
+  char *line;
+  while ((line = reader.read()) != NULL) {
+    IGCFix fix;
+    if (!IGCParseFix(line, fix) ||
+        (last_valid && fix.time <= last.Time))
+      continue;
+
+    state.Location = fix.location;
+    state.NavAltitude = positive(fix.pressure_altitude)
+      ? fix.pressure_altitude
+      : fix.gps_altitude;
+    state.AltitudeAGL = state.NavAltitude;
+    state.Time = fix.time;
+
+    if (last_valid) {
+      const GeoVector v = last.Location.distance_bearing(fix.location);
+      state.Speed = v.Distance / (fix.time - last.Time);
+      state.track = v.Distance >= fixed_one ? v.Bearing : last.track;
+    } else {
+      state.Speed = fixed_zero;
+      state.track = Angle::native(fixed_zero);
+    }
+
+    if (state.Speed > glide_polar.GetVTakeoff())
+      state.flying_state_moving(state.Time);
+    else
+      state.flying_state_stationary(state.Time);
+
+    flight.push_back(state);
+    last = state;
+    last_valid = true;
+  }
+
+  return !flight.empty();
+}
+
+static bool
+LoadTerrain(const char *directory)
+{
+  TCHAR jp2_path[4096];
+  _tcscpy(jp2_path, PathName(directory));
+  _tcscat(jp2_path, _T(DIR_SEPARATOR_S) _T("terrain.jp2"));
+
+  TCHAR j2w_path[4096];
+  _tcscpy(j2w_path, PathName(directory));
+  _tcscat(j2w_path, _T(DIR_SEPARATOR_S) _T("terrain.j2w"));
+
+  NullOperationEnvironment operation;
+  terrain_map = new RasterMap(jp2_path, j2w_path, NULL, operation);
+  if (!terrain_map->isMapLoaded()) {
+    delete terrain_map;
+    terrain_map = NULL;
+    return false;
+  }
+
+  do {
+    terrain_map->SetViewCenter(terrain_map->GetMapCenter(), fixed(100000));
+  } while (terrain_map->IsDirty());
+
+  return true;
+}
+
+/**
+ * Solves routes around random airspaces and over terrain to
+ * destinations in all directions.
+ */
+static unsigned long
+BenchmarkRouteSolve()
+{
+  Airspaces airspaces;
+  setup_airspaces(airspaces, terrain_map->GetMapCenter(), 28);
+
+  const GlidePolar polar(fixed_one);
+  const SpeedVector wind(Angle::degrees(fixed(0)), fixed(0));
+  AirspaceRoute route(polar, wind, airspaces);
+  route.set_terrain(terrain_map);
+
+  RoutePlannerConfig config;
+  config.mode = RoutePlannerConfig::rpBoth;
+
+  const GeoPoint origin = terrain_map->GetMapCenter();
+  const AGeoPoint start(origin, terrain_map->GetHeight(origin) + 100);
+
+  unsigned long expanded = 0;
+  for (unsigned distance = 20000; distance <= 60000; distance += 20000) {
+    for (unsigned i = 0; i < 16; ++i) {
+      const GeoPoint p = GeoVector(fixed(distance),
+                                   Angle::degrees(fixed(i * 22.5))).end_point(origin);
+      const AGeoPoint dest(p, terrain_map->GetHeight(p) + 100);
+
+      route.synchronise(airspaces, start, dest);
+      route.solve(start, dest, config);
+      expanded += route.get_count_expanded();
+    }
+  }
+
+  return expanded;
+}
+
+/**
+ * Builds the reach fan from the terrain centre at several altitudes,
+ * and queries arrival heights on a grid around it.
+ */
+static unsigned long
+BenchmarkReachFan()
+{
+  const GlidePolar polar(fixed_one);
+  const SpeedVector wind(Angle::degrees(fixed(0)), fixed(0));
+  TerrainRoute route(polar, wind);
+  route.set_terrain(terrain_map);
+
+  const GeoPoint origin = terrain_map->GetMapCenter();
+
+  unsigned long sum = 0;
+  for (unsigned height = 500; height <= 2000; height += 500) {
+    route.solve_reach(AGeoPoint(origin,
+                                terrain_map->GetHeight(origin) + height));
+
+    for (unsigned i = 0; i < 40; ++i) {
+      for (unsigned j = 0; j < 40; ++j) {
+        const GeoPoint p(origin.Longitude + Angle::degrees(fixed(i * 0.03 - 0.6)),
+                         origin.Latitude + Angle::degrees(fixed(j * 0.03 - 0.6)));
+        short reach, direct;
+        route.find_positive_arrival(AGeoPoint(p, terrain_map->GetHeight(p)),
+                                    reach, direct);
+        if (reach > 0)
+          sum += reach;
+      }
+    }
+  }
+
+  return sum;
+}
+
+/**
+ * Samples the terrain on a grid and looks for intersections along
+ * glide rays in all directions.
+ */
+static unsigned long
+BenchmarkTerrainScan()
+{
+  const GeoPoint origin = terrain_map->GetMapCenter();
+  const short h_origin = terrain_map->GetHeight(origin) + 500;
+
+  unsigned long sum = 0;
+  for (unsigned i = 0; i < 200; ++i) {
+    for (unsigned j = 0; j < 200; ++j) {
+      const GeoPoint p(origin.Longitude + Angle::degrees(fixed(i * 0.006 - 0.6)),
+                       origin.Latitude + Angle::degrees(fixed(j * 0.006 - 0.6)));
+      const short h = terrain_map->GetInterpolatedHeight(p);
+      if (h > 0)
+        sum += h;
+    }
+  }
+
+  for (unsigned i = 0; i < 360; ++i) {
+    const GeoPoint dest = GeoVector(fixed(50000),
+                                    Angle::degrees(fixed(i))).end_point(origin);
+    const GeoPoint intx = terrain_map->Intersection(origin, h_origin,
+                                                    h_origin, dest);
+    sum += (unsigned)origin.distance(intx);
+  }
+
+  return sum;
+}
+
+/**
+ * Solves the OLC Plus contest (which includes Classic and FAI) for
+ * the whole flight.
+ */
+static unsigned long
+BenchmarkOLCScore()
+{
+  static const unsigned handicap = 100;
+
+  Trace trace_full(60);
+  Trace trace_sprint(0, 9000, 300);
+  ContestManager contest_manager(OLC_Plus, handicap,
+                                 trace_full, trace_sprint);
+
+  for (std::vector<AIRCRAFT_STATE>::const_iterator i = flight.begin();
+       i != flight.end(); ++i) {
+    if (!i->Flying)
+      continue;
+
+    trace_full.append(*i);
+    trace_sprint.append(*i);
+    trace_full.optimise_if_old();
+    trace_sprint.optimise_if_old();
+  }
+
+  /* see RunBatchAnalysis: OLC Plus needs three passes */
+  for (unsigned pass = 0; pass < 3; ++pass)
+    contest_manager.solve_exhaustive();
+
+  return (unsigned)contest_manager.get_stats().result[2].score;
+}
+
+/**
+ * Flies the IGC flight through random airspaces, updating the
+ * warnings at every fix.
+ */
+static unsigned long
+BenchmarkAirspaceWarning()
+{
+  Airspaces airspaces;
+  setup_airspaces(airspaces, flight[flight.size() / 2].Location, 150);
+
+  const Waypoints waypoints;
+  TaskEvents task_events;
+  TaskManager task_manager(task_events, waypoints);
+
+  AirspaceWarningManager warnings(airspaces, task_manager);
+  warnings.reset(flight.front());
+
+  unsigned long changes = 0;
+  fixed last_time = flight.front().Time;
+  for (std::vector<AIRCRAFT_STATE>::const_iterator i = flight.begin();
+       i != flight.end(); ++i) {
+    const unsigned dt = (unsigned)(i->Time - last_time);
+    last_time = i->Time;
+
+    if (warnings.update(*i, false, dt))
+      ++changes;
+  }
+
+  return changes;
+}
+
+/**
+ * Appends the flight to a small trace, which has to be thinned over
+ * and over again.
+ */
+static unsigned long
+BenchmarkTraceThinning()
+{
+  Trace trace(60, Trace::null_time, 256);
+
+  for (std::vector<AIRCRAFT_STATE>::const_iterator i = flight.begin();
+       i != flight.end(); ++i) {
+    trace.append(*i);
+    trace.optimise_if_old();
+  }
+
+  TracePointVector points;
+  trace.get_trace_points(points);
+
+  unsigned long sum = 0;
+  for (TracePointVector::const_iterator i = points.begin();
+       i != points.end(); ++i)
+    sum += i->time;
+
+  return sum;
+}
+
+struct Benchmark {
+  const char *name;
+  bool needs_terrain;
+  unsigned long (*function)();
+};
+
+static const Benchmark benchmarks[] = {
+  { "route_solve", true, BenchmarkRouteSolve },
+  { "reach_fan", true, BenchmarkReachFan },
+  { "terrain_scan", true, BenchmarkTerrainScan },
+  { "olc_score", false, BenchmarkOLCScore },
+  { "airspace_warning", false, BenchmarkAirspaceWarning },
+  { "trace_thinning", false, BenchmarkTraceThinning },
+  { NULL, false, NULL }
+};
+
+static void
+RunBenchmark(const Benchmark &benchmark, unsigned runs)
+{
+  std::vector<unsigned> durations;
+  unsigned long result = 0;
+
+  for (unsigned i = 0; i < runs; ++i) {
+    srand(BENCHMARK_SEED);
+
+    const unsigned start = MonotonicClockUS();
+    const unsigned long r = benchmark.function();
+    durations.push_back(MonotonicClockUS() - start);
+
+    if (i > 0 && r != result)
+      fprintf(stderr, "%s: result is not deterministic\n", benchmark.name);
+    result = r;
+  }
+
+  std::sort(durations.begin(), durations.end());
+
+  printf("%s %u %u %u %lu\n", benchmark.name, runs,
+         durations[durations.size() / 2], durations.front(), result);
+  fflush(stdout);
+}
+
+static void
+Usage(const char *argv0)
+{
+  fprintf(stderr,
+          "Usage: %s [-n RUNS] [-t TERRAIN_DIR] [-f FILE.igc] [NAME ...]\n",
+          argv0);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned runs = DEFAULT_RUNS;
+  const char *terrain_path = "test/data/benalla9.xcm";
+  const char *flight_path = "test/data/01lz1hq1.igc";
+
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; ++i) {
+    if (i + 1 >= argc) {
+      Usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (strcmp(argv[i], "-n") == 0)
+      runs = std::max(atoi(argv[++i]), 1);
+    else if (strcmp(argv[i], "-t") == 0)
+      terrain_path = argv[++i];
+    else if (strcmp(argv[i], "-f") == 0)
+      flight_path = argv[++i];
+    else {
+      Usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  /* the remaining arguments select benchmarks by name */
+  char **names = argv + i;
+  const unsigned n_names = argc - i;
+
+  if (!LoadFlight(flight_path)) {
+    fprintf(stderr, "Failed to load %s\n", flight_path);
+    return EXIT_FAILURE;
+  }
+
+  const bool have_terrain = LoadTerrain(terrain_path);
+  if (!have_terrain)
+    fprintf(stderr, "Failed to load terrain from %s\n", terrain_path);
+
+  printf("# name runs median_us min_us result\n");
+
+  for (const Benchmark *b = benchmarks; b->name != NULL; ++b) {
+    if (n_names > 0) {
+      bool selected = false;
+      for (unsigned j = 0; j < n_names; ++j)
+        if (strcmp(names[j], b->name) == 0)
+          selected = true;
+
+      if (!selected)
+        continue;
+    }
+
+    if (b->needs_terrain && !have_terrain) {
+      printf("# %s skipped\n", b->name);
+      continue;
+    }
+
+    RunBenchmark(*b, runs);
+  }
+
+  delete terrain_map;
+  return EXIT_SUCCESS;
+}
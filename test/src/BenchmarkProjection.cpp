@@ -23,6 +23,9 @@ Copyright_License {
 
 #include "Projection.hpp"
 #include "Screen/Layout.hpp"
+#include "OS/Clock.hpp"
+
+#include <stdio.h>
 
 unsigned Layout::scale_1024 = 1024;
 
@@ -36,20 +39,56 @@ public:
   }
 };
 
+enum {
+  NUM_POINTS = 1024,
+  NUM_ROUNDS = 64 * 1024,
+};
+
+static void
+Report(const char *name, unsigned duration_ms)
+{
+  if (duration_ms == 0)
+    duration_ms = 1;
+
+  printf("%s: %u ms, %lu points/s\n", name, duration_ms,
+         (unsigned long)((double)NUM_POINTS * NUM_ROUNDS * 1000
+                         / duration_ms));
+}
+
 int main(int argc, char **argv)
 {
   TestProjection projection;
 
-  GeoPoint gp = GeoPoint(Angle::degrees(fixed(7.7061111111111114)),
-                         Angle::degrees(fixed(51.051944444444445)));
+  /* a polyline around the projection's origin */
+  static GeoPoint geo_points[NUM_POINTS];
+  for (unsigned i = 0; i < NUM_POINTS; ++i)
+    geo_points[i] =
+      GeoPoint(Angle::degrees(fixed(7.7061111111111114 + 0.0001 * i)),
+               Angle::degrees(fixed(51.051944444444445 - 0.00005 * i)));
+
+  static RasterPoint raster_points[NUM_POINTS];
   long x = 0, y = 0;
-  for (unsigned i = 64 * 1024 * 1024; i-- > 0;) {
-    RasterPoint rp = projection.GeoToScreen(gp);
+
+  unsigned start = MonotonicClockMS();
+  for (unsigned round = 0; round < NUM_ROUNDS; ++round) {
+    for (unsigned i = 0; i < NUM_POINTS; ++i)
+      raster_points[i] = projection.GeoToScreen(geo_points[i]);
 
     /* prevent gcc from optimizing this loop away */
-    x += rp.x;
-    y += rp.y;
+    x += raster_points[round % NUM_POINTS].x;
+    y += raster_points[round % NUM_POINTS].y;
+  }
+  Report("single", MonotonicClockMS() - start);
+
+  start = MonotonicClockMS();
+  for (unsigned round = 0; round < NUM_ROUNDS; ++round) {
+    projection.GeoToScreen(geo_points, raster_points, NUM_POINTS);
+
+    x -= raster_points[round % NUM_POINTS].x;
+    y -= raster_points[round % NUM_POINTS].y;
   }
+  Report("batch", MonotonicClockMS() - start);
 
-  return x + y;
+  /* both paths must yield the same coordinates */
+  return x != 0 || y != 0;
 }
@@ -733,9 +733,11 @@ void PrintHelper::print_route(RoutePlanner& r)
   printf("# solution\n");
   printf("# stats:\n");
   printf("#   dijkstra links %d\n", (int)r.count_dij);
+  printf("#   nodes expanded %d\n", (int)r.count_expanded);
   printf("#   unique links %d\n", (int)r.count_unique);
   printf("#   airspace queries %d\n", (int)r.count_airspace);
   printf("#   terrain queries %d\n", (int)r.count_terrain);
+  printf("#   terrain queries cached %d\n", (int)r.count_terrain_cached);
   printf("#   supressed %d\n", (int)r.count_supressed);
 }
 
@@ -0,0 +1,584 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program analyses a large number of IGC files in parallel.
+ * Each flight gets its own #TaskManager and #ContestManager, and the
+ * results are printed as CSV or JSON table.  The climb statistics
+ * are approximate, see #ClimbDetector.
+ */
+
+#include "Replay/IGCParser.hpp"
+#include "IO/FileLineReader.hpp"
+#include "OS/FileUtil.hpp"
+#include "OS/PathName.hpp"
+#include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Engine/Task/TaskEvents.hpp"
+#include "Engine/Task/Tasks/ContestManager.hpp"
+#include "Engine/Task/Tasks/OrderedTask.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+#include "Engine/Util/Deserialiser.hpp"
+#include "Util/DataNodeXML.hpp"
+#include "Util/tstring.hpp"
+#include "DateTime.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+/**
+ * Thresholds for circling detection, the same as in
+ * GlideComputerAirData::Turning().
+ */
+static const fixed MinTurnRate(4);
+static const fixed CruiseClimbSwitch(15);
+static const fixed ClimbCruiseSwitch(10);
+
+/**
+ * An approximation of the circling detection in
+ * #GlideComputerAirData, which collects statistics about all climbs
+ * of a flight.  It uses the same thresholds and turn rate filter, but
+ * ignores external cruise/climb switches and measures the altitude
+ * gain without energy height, so its numbers may differ from those
+ * XCSoar shows in flight.
+ */
+class ClimbDetector {
+  bool circling;
+
+  /** the time when the turn rate crossed #MinTurnRate */
+  fixed switch_time;
+  fixed switch_altitude;
+
+  fixed climb_start_time, climb_start_altitude;
+
+  fixed smoothed_rate;
+
+public:
+  unsigned climbs;
+  fixed climb_time, climb_gain;
+
+  ClimbDetector()
+    :circling(false), switch_time(fixed_minus_one),
+     smoothed_rate(fixed_zero),
+     climbs(0), climb_time(fixed_zero), climb_gain(fixed_zero) {}
+
+  void Update(const AIRCRAFT_STATE &state, const AIRCRAFT_STATE &last) {
+    const fixed dt = state.Time - last.Time;
+    if (!positive(dt) || !state.Flying)
+      return;
+
+    fixed rate = (state.track - last.track).as_delta().value_degrees() / dt;
+    rate = max(fixed(-50), min(fixed(50), rate));
+    smoothed_rate = fixed(0.3) * rate + fixed(0.7) * smoothed_rate;
+
+    const bool turning = fabs(smoothed_rate) >= MinTurnRate;
+    if (turning == circling) {
+      switch_time = fixed_minus_one;
+      return;
+    }
+
+    if (negative(switch_time)) {
+      switch_time = state.Time;
+      switch_altitude = state.NavAltitude;
+      return;
+    }
+
+    if (state.Time - switch_time <= (circling
+                                     ? ClimbCruiseSwitch
+                                     : CruiseClimbSwitch))
+      return;
+
+    if (circling) {
+      climb_time += switch_time - climb_start_time;
+      climb_gain += switch_altitude - climb_start_altitude;
+    } else {
+      climb_start_time = switch_time;
+      climb_start_altitude = switch_altitude;
+      ++climbs;
+    }
+
+    circling = !circling;
+    switch_time = fixed_minus_one;
+  }
+
+  void Finish(const AIRCRAFT_STATE &state) {
+    if (circling) {
+      climb_time += state.Time - climb_start_time;
+      climb_gain += state.NavAltitude - climb_start_altitude;
+      circling = false;
+    }
+  }
+};
+
+struct FlightResult {
+  bool valid;
+
+  BrokenDate date;
+  unsigned fixes;
+  fixed takeoff_time, landing_time;
+
+  ContestStatistics contest;
+
+  bool task_started, task_finished;
+  fixed task_distance, task_speed;
+
+  unsigned climbs;
+  fixed climb_time, climb_gain;
+
+  FlightResult()
+    :valid(false), date(0, 0, 0), fixes(0),
+     takeoff_time(fixed_minus_one), landing_time(fixed_minus_one),
+     task_started(false), task_finished(false),
+     task_distance(fixed_zero), task_speed(fixed_zero),
+     climbs(0), climb_time(fixed_zero), climb_gain(fixed_zero) {
+    contest.reset();
+  }
+};
+
+struct FlightJob {
+  tstring path;
+  FlightResult result;
+
+  FlightJob(const TCHAR *_path):path(_path) {}
+};
+
+static Contests contest = OLC_Plus;
+static const char *task_path = NULL;
+
+/**
+ * Protects the XML parser, which is not thread-safe, while loading
+ * the task.
+ */
+static Mutex task_mutex;
+
+static OrderedTask *
+LoadTask(TaskManager &task_manager, TaskEvents &task_events)
+{
+  ScopeLock protect(task_mutex);
+
+  PathName path(task_path);
+  DataNode *root = DataNodeXML::load(path);
+  if (root == NULL)
+    return NULL;
+
+  OrderedTask *task = new OrderedTask(task_events,
+                                      task_manager.get_task_behaviour(),
+                                      task_manager.get_glide_polar());
+  Deserialiser des(*root);
+  des.deserialise(*task);
+  delete root;
+
+  if (!task->check_task()) {
+    delete task;
+    return NULL;
+  }
+
+  return task;
+}
+
+static void
+AnalyseFlight(const TCHAR *path, FlightResult &result)
+{
+  FileLineReaderA reader(path);
+  if (reader.error())
+    return;
+
+  const Waypoints waypoints;
+  TaskEvents task_events;
+  TaskManager task_manager(task_events, waypoints);
+
+  GlidePolar glide_polar(fixed_zero);
+  task_manager.set_glide_polar(glide_polar);
+
+  TaskBehaviour task_behaviour = task_manager.get_task_behaviour();
+  task_behaviour.enable_olc = false;
+  task_behaviour.enable_trace = false;
+  task_manager.set_task_behaviour(task_behaviour);
+
+  if (task_path != NULL) {
+    OrderedTask *task = LoadTask(task_manager, task_events);
+    if (task == NULL)
+      return;
+
+    task_manager.commit(*task);
+    task_manager.resume();
+    delete task;
+  }
+
+  /* the same trace parameters as TaskManager's */
+  Trace trace_full(60);
+  Trace trace_sprint(0, 9000, 300);
+  ContestManager contest_manager(contest, task_behaviour.contest_handicap,
+                                 trace_full, trace_sprint);
+
+  ClimbDetector climb_detector;
+
+  AIRCRAFT_STATE state, last;
+  bool last_valid = false;
+
+  char *line;
+  while ((line = reader.read()) != NULL) {
+    IGCFix fix;
+    if (!IGCParseFix(line, fix)) {
+      BrokenDate date;
+      if (IGCParseDate(line, date))
+        result.date = date;
+      continue;
+    }
+
+    if (last_valid && fix.time <= last.Time)
+      continue;
+
+    state.Location = fix.location;
+    state.NavAltitude = positive(fix.pressure_altitude)
+      ? fix.pressure_altitude
+      : fix.gps_altitude;
+    state.AltitudeAGL = state.NavAltitude;
+    state.Time = fix.time;
+
+    if (last_valid) {
+      const GeoVector v = last.Location.distance_bearing(fix.location);
+      state.Speed = v.Distance / (fix.time - last.Time);
+      state.track = v.Distance >= fixed_one ? v.Bearing : last.track;
+    } else {
+      state.Speed = fixed_zero;
+      state.track = Angle::native(fixed_zero);
+      last = state;
+    }
+
+    if (state.Speed > glide_polar.GetVTakeoff())
+      state.flying_state_moving(state.Time);
+    else
+      state.flying_state_stationary(state.Time);
+
+    if (state.Flying) {
+      if (negative(result.takeoff_time))
+        result.takeoff_time = state.Time;
+      result.landing_time = state.Time;
+
+      trace_full.append(state);
+      trace_sprint.append(state);
+      trace_full.optimise_if_old();
+      trace_sprint.optimise_if_old();
+    }
+
+    task_manager.update(state, last);
+    task_manager.update_idle(state);
+    task_manager.get_task_advance().set_armed(true);
+
+    climb_detector.Update(state, last);
+
+    ++result.fixes;
+    last = state;
+    last_valid = true;
+  }
+
+  if (last_valid)
+    climb_detector.Finish(last);
+
+  /* the first pass loads the traces into the solvers, the second
+     one solves; OLC Plus needs a third one, because it is derived
+     from the Classic and FAI results */
+  for (unsigned pass = 0; pass < 3; ++pass)
+    contest_manager.solve_exhaustive();
+
+  const TaskStats &stats = task_manager.get_stats();
+
+  result.contest = contest_manager.get_stats();
+  result.task_started = stats.task_started;
+  result.task_finished = stats.task_finished;
+  result.task_distance = stats.total.travelled.get_distance();
+  result.task_speed = stats.total.travelled.get_speed();
+  result.climbs = climb_detector.climbs;
+  result.climb_time = climb_detector.climb_time;
+  result.climb_gain = climb_detector.climb_gain;
+  result.valid = true;
+}
+
+/**
+ * Takes flights from a shared list until there are none left.  The
+ * flights are independent and coarse-grained, so one shared cursor
+ * keeps all threads busy until the end.
+ */
+class AnalysisThread : public Thread {
+  std::vector<FlightJob> &jobs;
+  Mutex &mutex;
+  unsigned &next;
+
+public:
+  AnalysisThread(std::vector<FlightJob> &_jobs, Mutex &_mutex,
+                 unsigned &_next)
+    :jobs(_jobs), mutex(_mutex), next(_next) {}
+
+protected:
+  virtual void Run();
+};
+
+void
+AnalysisThread::Run()
+{
+  while (true) {
+    unsigned i;
+
+    {
+      ScopeLock protect(mutex);
+      if (next >= jobs.size())
+        return;
+
+      i = next++;
+    }
+
+    FlightJob &job = jobs[i];
+    AnalyseFlight(job.path.c_str(), job.result);
+  }
+}
+
+class IGCFileVisitor : public File::Visitor {
+  std::vector<FlightJob> &jobs;
+
+public:
+  IGCFileVisitor(std::vector<FlightJob> &_jobs):jobs(_jobs) {}
+
+  virtual void Visit(const TCHAR *path, const TCHAR *filename) {
+    jobs.push_back(FlightJob(path));
+  }
+};
+
+static unsigned
+CountProcessors()
+{
+#ifdef HAVE_POSIX
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (unsigned)n : 1;
+#else
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors;
+#endif
+}
+
+static void
+PrintTime(fixed time)
+{
+  if (negative(time)) {
+    printf("null");
+    return;
+  }
+
+  const unsigned t = (unsigned)time;
+  printf("\"%02u:%02u:%02u\"", t / 3600, t / 60 % 60, t % 60);
+}
+
+static void
+PrintCSVHeader()
+{
+  printf("file,date,fixes,takeoff,landing");
+  for (unsigned i = 0; i < 3; ++i)
+    printf(",score%u,distance%u,speed%u", i, i, i);
+  printf(",task_started,task_finished,task_distance,task_speed"
+         ",approx_climbs,approx_climb_time,approx_climb_rate\n");
+}
+
+static void
+PrintCSV(const FlightJob &job)
+{
+  const FlightResult &r = job.result;
+
+  _tprintf(_T("\"%s\",%04u-%02u-%02u,%u,"), job.path.c_str(),
+           r.date.year, r.date.month, r.date.day, r.fixes);
+  PrintTime(r.takeoff_time);
+  putchar(',');
+  PrintTime(r.landing_time);
+
+  for (unsigned i = 0; i < 3; ++i) {
+    const ContestResult &c = r.contest.result[i];
+    printf(",%.2f,%.3f,%.2f", (double)c.score,
+           (double)c.distance / 1000, (double)c.speed * 3.6);
+  }
+
+  printf(",%d,%d,%.3f,%.2f,%u,%u,%.2f\n",
+         r.task_started, r.task_finished,
+         (double)r.task_distance / 1000, (double)r.task_speed * 3.6,
+         r.climbs, (unsigned)r.climb_time,
+         positive(r.climb_time)
+         ? (double)(r.climb_gain / r.climb_time) : 0.);
+}
+
+static void
+PrintJSONString(const TCHAR *s)
+{
+  putchar('"');
+  for (; *s != _T('\0'); ++s) {
+    if (*s == _T('"') || *s == _T('\\'))
+      _tprintf(_T("\\%c"), *s);
+    else
+      _tprintf(_T("%c"), *s);
+  }
+  putchar('"');
+}
+
+static void
+PrintJSON(const FlightJob &job, bool last)
+{
+  const FlightResult &r = job.result;
+
+  printf("  {\"file\": ");
+  PrintJSONString(job.path.c_str());
+  printf(", \"date\": \"%04u-%02u-%02u\", \"fixes\": %u",
+         r.date.year, r.date.month, r.date.day, r.fixes);
+  printf(", \"takeoff\": ");
+  PrintTime(r.takeoff_time);
+  printf(", \"landing\": ");
+  PrintTime(r.landing_time);
+
+  printf(",\n   \"contest\": [");
+  for (unsigned i = 0; i < 3; ++i) {
+    const ContestResult &c = r.contest.result[i];
+    printf("%s{\"score\": %.2f, \"distance\": %.3f, \"speed\": %.2f}",
+           i > 0 ? ", " : "", (double)c.score,
+           (double)c.distance / 1000, (double)c.speed * 3.6);
+  }
+  printf("],\n");
+
+  printf("   \"task\": {\"started\": %s, \"finished\": %s"
+         ", \"distance\": %.3f, \"speed\": %.2f},\n",
+         r.task_started ? "true" : "false",
+         r.task_finished ? "true" : "false",
+         (double)r.task_distance / 1000, (double)r.task_speed * 3.6);
+
+  printf("   \"thermals\": {\"approximate\": true"
+         ", \"climbs\": %u, \"time\": %u, \"rate\": %.2f}}%s\n",
+         r.climbs, (unsigned)r.climb_time,
+         positive(r.climb_time) ? (double)(r.climb_gain / r.climb_time) : 0.,
+         last ? "" : ",");
+}
+
+static void
+Usage(const char *argv0)
+{
+  fprintf(stderr, "Usage: %s [-j THREADS] [-c CONTEST] [-t TASK.tsk] [--json]"
+          " PATH ...\n"
+          "PATH may be an IGC file or a directory containing IGC files\n",
+          argv0);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned n_threads = CountProcessors();
+  bool json = false;
+
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; ++i) {
+    if (strcmp(argv[i], "--json") == 0)
+      json = true;
+    else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+      n_threads = std::max(atoi(argv[++i]), 1);
+    else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+      contest = (Contests)atoi(argv[++i]);
+    else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+      task_path = argv[++i];
+    else {
+      Usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (i >= argc || contest > OLC_SISAT) {
+    Usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<FlightJob> jobs;
+  IGCFileVisitor visitor(jobs);
+  for (; i < argc; ++i) {
+    PathName path(argv[i]);
+    if (Directory::Exists(path))
+      Directory::VisitSpecificFiles(path, _T("*.igc"), visitor, true);
+    else
+      jobs.push_back(FlightJob(path));
+  }
+
+  if (n_threads > jobs.size())
+    n_threads = std::max((unsigned)jobs.size(), 1u);
+
+  Mutex mutex;
+  unsigned next = 0;
+
+  std::vector<AnalysisThread *> threads;
+  for (unsigned j = 0; j < n_threads; ++j) {
+    AnalysisThread *thread = new AnalysisThread(jobs, mutex, next);
+    if (!thread->Start()) {
+      delete thread;
+      break;
+    }
+
+    threads.push_back(thread);
+  }
+
+  if (threads.empty()) {
+    fprintf(stderr, "Failed to start threads\n");
+    return EXIT_FAILURE;
+  }
+
+  for (unsigned j = 0; j < threads.size(); ++j) {
+    threads[j]->Join();
+    delete threads[j];
+  }
+
+  if (json)
+    printf("[\n");
+  else
+    PrintCSVHeader();
+
+  unsigned n_failed = 0;
+  for (unsigned j = 0; j < jobs.size(); ++j) {
+    const FlightJob &job = jobs[j];
+    if (!job.result.valid) {
+      _ftprintf(stderr, _T("Failed to analyse %s\n"), job.path.c_str());
+      ++n_failed;
+    }
+
+    if (json)
+      PrintJSON(job, j + 1 == jobs.size());
+    else
+      PrintCSV(job);
+  }
+
+  if (json)
+    printf("]\n");
+
+  return n_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,318 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Re-scores completed flights for the online contests.  Unlike the
+ * live ContestManager, which works on the thinned in-flight trace and
+ * solves incrementally, this loads every fix of the IGC file (up to
+ * a configurable point budget), runs the exhaustive search, and
+ * solves independent contest solvers in parallel threads.
+ */
+
+#include "Replay/IGCParser.hpp"
+#include "IO/FileLineReader.hpp"
+#include "OS/Clock.hpp"
+#include "Thread/Thread.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Engine/Task/Tasks/PathSolvers/OLCSprint.hpp"
+#include "Engine/Task/Tasks/PathSolvers/OLCFAI.hpp"
+#include "Engine/Task/Tasks/PathSolvers/OLCClassic.hpp"
+#include "Engine/Task/Tasks/PathSolvers/OLCLeague.hpp"
+#include "Engine/Task/Tasks/PathSolvers/OLCPlus.hpp"
+#include "Engine/Task/Tasks/PathSolvers/XContestFree.hpp"
+#include "Engine/Task/Tasks/PathSolvers/XContestTriangle.hpp"
+#include "Engine/Task/Tasks/PathSolvers/OLCSISAT.hpp"
+#include "Engine/Task/Tasks/PathSolvers/Contests.hpp"
+#include "Engine/Task/TaskStats/ContestStatistics.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+static Contests contest = OLC_Plus;
+static unsigned handicap = 100;
+
+/**
+ * The maximum number of trace points passed to the solvers.  The
+ * live trace keeps 1000; the exhaustive search is quadratic in this
+ * number, so it is bounded even offline.
+ */
+static unsigned max_points = 5000;
+
+static bool verbose = false;
+
+/**
+ * Runs one solver to completion and scores it.
+ */
+static void
+Solve(AbstractContest &solver, ContestResult &result,
+      ContestTraceVector &solution)
+{
+  /* the first call loads the trace into the solver, the second one
+     runs the exhaustive search */
+  solver.solve(true);
+  solver.solve(true);
+
+  if (solver.score(result))
+    solver.copy_solution(solution);
+}
+
+/**
+ * Solves one contest in its own thread.  The solvers only read the
+ * shared #Trace, so independent ones can run concurrently.
+ */
+class SolverThread : public Thread {
+  AbstractContest &solver;
+  ContestResult &result;
+  ContestTraceVector &solution;
+
+public:
+  SolverThread(AbstractContest &_solver, ContestResult &_result,
+               ContestTraceVector &_solution)
+    :solver(_solver), result(_result), solution(_solution) {}
+
+protected:
+  virtual void Run() {
+    Solve(solver, result, solution);
+  }
+};
+
+/**
+ * Solves two independent contests, the first one in a new thread and
+ * the second one in the calling thread.
+ */
+static void
+SolveParallel(AbstractContest &a, unsigned index_a,
+              AbstractContest &b, unsigned index_b,
+              ContestStatistics &stats)
+{
+  SolverThread thread(a, stats.result[index_a], stats.solution[index_a]);
+  const bool started = thread.Start();
+  if (!started)
+    Solve(a, stats.result[index_a], stats.solution[index_a]);
+
+  Solve(b, stats.result[index_b], stats.solution[index_b]);
+
+  if (started)
+    thread.Join();
+}
+
+/**
+ * Solves the selected contest, storing the results at the same
+ * indices as ContestManager::update_idle() does.
+ */
+static void
+SolveContest(const Trace &trace_full, const Trace &trace_sprint,
+             ContestStatistics &stats)
+{
+  switch (contest) {
+  case OLC_Sprint: {
+    OLCSprint solver(trace_sprint, handicap);
+    Solve(solver, stats.result[0], stats.solution[0]);
+    break;
+  }
+
+  case OLC_FAI: {
+    OLCFAI solver(trace_full, handicap);
+    Solve(solver, stats.result[0], stats.solution[0]);
+    break;
+  }
+
+  case OLC_Classic: {
+    OLCClassic solver(trace_full, handicap);
+    Solve(solver, stats.result[0], stats.solution[0]);
+    break;
+  }
+
+  case OLC_League: {
+    OLCClassic classic(trace_full, handicap);
+    Solve(classic, stats.result[1], stats.solution[1]);
+
+    OLCLeague league(trace_sprint, handicap);
+    league.get_solution_classic() = stats.solution[1];
+    Solve(league, stats.result[0], stats.solution[0]);
+    break;
+  }
+
+  case OLC_Plus: {
+    OLCClassic classic(trace_full, handicap);
+    OLCFAI fai(trace_full, handicap);
+    SolveParallel(classic, 0, fai, 1, stats);
+
+    OLCPlus plus(trace_full, handicap);
+    plus.get_result_classic() = stats.result[0];
+    plus.get_solution_classic() = stats.solution[0];
+    plus.get_result_fai() = stats.result[1];
+    plus.get_solution_fai() = stats.solution[1];
+    Solve(plus, stats.result[2], stats.solution[2]);
+    break;
+  }
+
+  case OLC_XContest:
+  case OLC_DHVXC: {
+    const bool dhv = contest == OLC_DHVXC;
+    XContestFree free_flight(trace_full, handicap, dhv);
+    XContestTriangle triangle(trace_full, handicap, dhv);
+    SolveParallel(free_flight, 0, triangle, 1, stats);
+    break;
+  }
+
+  case OLC_SISAT: {
+    OLCSISAT solver(trace_full, handicap);
+    Solve(solver, stats.result[0], stats.solution[0]);
+    break;
+  }
+  }
+}
+
+static const char *const result_names[][3] = {
+  { "sprint", NULL, NULL },
+  { "fai", NULL, NULL },
+  { "classic", NULL, NULL },
+  { "league", "classic", NULL },
+  { "classic", "fai", "plus" },
+  { "free", "triangle", NULL },
+  { "free", "triangle", NULL },
+  { "sisat", NULL, NULL },
+};
+
+static void
+PrintSolution(const ContestTraceVector &solution)
+{
+  for (ContestTraceVector::const_iterator it = solution.begin();
+       it != solution.end(); ++it) {
+    const unsigned t = it->time;
+    printf("    %02u:%02u:%02u %10.5f %10.5f %5d\n",
+           t / 3600, t / 60 % 60, t % 60,
+           (double)it->get_location().Latitude.value_degrees(),
+           (double)it->get_location().Longitude.value_degrees(),
+           (int)it->GetAltitude());
+  }
+}
+
+static bool
+ScoreFlight(const char *path)
+{
+  FileLineReaderA reader(path);
+  if (reader.error()) {
+    fprintf(stderr, "Failed to open %s\n", path);
+    return false;
+  }
+
+  /* keep every fix, unless the flight exceeds the point budget; the
+     sprint trace covers the same 2.5 hour window as the live one */
+  Trace trace_full(0, Trace::null_time, max_points);
+  Trace trace_sprint(0, 9000, max_points);
+
+  unsigned fixes = 0;
+
+  char *line;
+  while ((line = reader.read()) != NULL) {
+    IGCFix fix;
+    if (!IGCParseFix(line, fix))
+      continue;
+
+    AIRCRAFT_STATE state;
+    state.Location = fix.location;
+    state.NavAltitude = positive(fix.pressure_altitude)
+      ? fix.pressure_altitude
+      : fix.gps_altitude;
+    state.AltitudeAGL = state.NavAltitude;
+    state.Time = fix.time;
+    state.Speed = fixed_zero;
+    state.track = Angle::native(fixed_zero);
+
+    trace_full.append(state);
+    trace_sprint.append(state);
+    trace_full.optimise_if_old();
+    trace_sprint.optimise_if_old();
+
+    ++fixes;
+  }
+
+  const unsigned start = MonotonicClockMS();
+
+  ContestStatistics stats;
+  stats.reset();
+  SolveContest(trace_full, trace_sprint, stats);
+
+  const unsigned duration = MonotonicClockMS() - start;
+
+  printf("%s: %u fixes, %u points, solved in %u ms\n",
+         path, fixes, trace_full.size(), duration);
+
+  for (unsigned i = 0; i < 3; ++i) {
+    const char *name = result_names[contest][i];
+    if (name == NULL)
+      break;
+
+    const ContestResult &result = stats.result[i];
+    printf("  %-8s score %8.2f  distance %8.3f km  speed %6.2f km/h"
+           "  time %5u s\n",
+           name, (double)result.score, (double)result.distance / 1000,
+           (double)result.speed * 3.6, (unsigned)result.time);
+
+    if (verbose)
+      PrintSolution(stats.solution[i]);
+  }
+
+  return true;
+}
+
+static void
+Usage(const char *argv0)
+{
+  fprintf(stderr, "Usage: %s [-c CONTEST] [-h HANDICAP] [-p POINTS] [-v]"
+          " FILE.igc ...\n", argv0);
+}
+
+int main(int argc, char **argv)
+{
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; ++i) {
+    if (strcmp(argv[i], "-v") == 0)
+      verbose = true;
+    else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+      contest = (Contests)atoi(argv[++i]);
+    else if (strcmp(argv[i], "-h") == 0 && i + 1 < argc)
+      handicap = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+      max_points = atoi(argv[++i]);
+    else {
+      Usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (i >= argc || contest > OLC_SISAT || handicap == 0 || max_points < 10) {
+    Usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  bool success = true;
+  for (; i < argc; ++i)
+    success &= ScoreFlight(argv[i]);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,460 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * This program feeds IGC or NMEA files through the complete
+ * #GlideComputer as fast as possible, without a user interface and
+ * without threads, and reports how much wall clock time each stage of
+ * the calculation pipeline took.
+ */
+
+#include "GlideComputer.hpp"
+#include "GlideComputerInterface.hpp"
+#include "BasicComputer.hpp"
+#include "SettingsComputerBlackboard.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "Airspace/ProtectedAirspaceWarningManager.hpp"
+#include "Airspace/AirspaceParser.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceWarningManager.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Replay/IGCParser.hpp"
+#include "Device/Parser.hpp"
+#include "IO/FileLineReader.hpp"
+#include "OS/PathName.hpp"
+#include "OS/Clock.hpp"
+#include "CalculationProfiler.hpp"
+#include "UtilsFile.hpp"
+#include "DateTime.hpp"
+#include "Operation.hpp"
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* fake symbols: */
+
+#include "ConditionMonitor.hpp"
+#include "Device/device.hpp"
+#include "InputEvents.hpp"
+#include "Logger/Logger.hpp"
+#include "LocalTime.hpp"
+#include "Components.hpp"
+#include "Task/TaskFile.hpp"
+
+RasterTerrain *terrain;
+
+TaskFile*
+TaskFile::Create(const TCHAR* path)
+{
+  return NULL;
+}
+
+bool HaveCondorDevice() { return false; }
+
+void ConditionMonitorsUpdate(const GlideComputer &cmp) {}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+bool InputEvents::processNmea(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEA_INFO &gps_info) {}
+void Logger::LogFinishEvent(const NMEA_INFO &gps_info) {}
+void Logger::LogPoint(const NMEA_INFO &gps_info) {}
+
+int GetUTCOffset() { return 0; }
+
+/* done with fake symbols. */
+
+/**
+ * Accumulates the wall clock time spent in one stage of the pipeline.
+ */
+struct StageTiming {
+  const char *name;
+
+  double total_us;
+  unsigned max_us;
+  unsigned count;
+
+  StageTiming(const char *_name)
+    :name(_name), total_us(0), max_us(0), count(0) {}
+
+  void Add(unsigned us) {
+    total_us += us;
+    if (us > max_us)
+      max_us = us;
+    ++count;
+  }
+
+  void Add(const StageTiming &other) {
+    total_us += other.total_us;
+    if (other.max_us > max_us)
+      max_us = other.max_us;
+    count += other.count;
+  }
+
+  void Print() const {
+    printf("  %-8s %10.1f ms %8.1f us/call %8u us max\n",
+           name, total_us / 1000,
+           count > 0 ? total_us / count : 0., max_us);
+  }
+};
+
+/**
+ * Measures the duration of one stage with a microsecond clock.
+ */
+class ScopeTiming {
+  StageTiming &timing;
+  unsigned start;
+
+public:
+  ScopeTiming(StageTiming &_timing)
+    :timing(_timing), start(MonotonicClockUS()) {}
+
+  ~ScopeTiming() {
+    timing.Add(MonotonicClockUS() - start);
+  }
+};
+
+struct ReplayTimings {
+  StageTiming parse, basic, gps, idle;
+
+  unsigned fixes;
+  fixed flight_time;
+
+  ReplayTimings()
+    :parse("parse"), basic("basic"), gps("gps"), idle("idle"),
+     fixes(0), flight_time(fixed_zero) {}
+
+  double GetTotalUS() const {
+    return parse.total_us + basic.total_us + gps.total_us + idle.total_us;
+  }
+
+  void Add(const ReplayTimings &other) {
+    parse.Add(other.parse);
+    basic.Add(other.basic);
+    gps.Add(other.gps);
+    idle.Add(other.idle);
+    fixes += other.fixes;
+    flight_time += other.flight_time;
+  }
+
+  void Print() const {
+    const double total_s = GetTotalUS() / 1000000;
+    printf("  %u fixes, %u s flight time, %.3f s elapsed",
+           fixes, (unsigned)flight_time, total_s);
+    if (total_s > 0)
+      printf(", %.0fx real time", (double)flight_time / total_s);
+    printf("\n");
+
+    parse.Print();
+    basic.Print();
+    gps.Print();
+    idle.Print();
+  }
+};
+
+/**
+ * Owns one instance of the calculation pipeline, and feeds sensor
+ * data into it.
+ */
+class HeadlessReplay {
+  SettingsComputerBlackboard settings;
+
+  const Waypoints way_points;
+
+  GlideComputerTaskEvents task_events;
+  TaskManager task_manager;
+
+  AirspaceWarningManager airspace_warning;
+  ProtectedAirspaceWarningManager airspace_warnings;
+
+  ProtectedTaskManager protected_task_manager;
+
+  GlideComputer glide_computer;
+  BasicComputer basic_computer;
+
+  MoreData basic, last;
+
+  fixed first_time;
+
+public:
+  ReplayTimings timings;
+
+  HeadlessReplay(Airspaces &airspace_database)
+    :task_manager(task_events, way_points),
+     airspace_warning(airspace_database, task_manager),
+     airspace_warnings(airspace_warning),
+     protected_task_manager(task_manager, settings.SettingsComputer(),
+                            task_events, airspace_database),
+     glide_computer(way_points, airspace_database,
+                    protected_task_manager, airspace_warnings,
+                    task_events),
+     first_time(fixed_minus_one) {
+    glide_computer.Initialise();
+    glide_computer.ReadSettingsComputer(settings.SettingsComputer());
+    glide_computer.SetScreenDistanceMeters(fixed(50000));
+
+    basic.Reset();
+    last.Reset();
+  }
+
+  MoreData &GetBasic() {
+    return basic;
+  }
+
+  /**
+   * Runs the whole pipeline for the sensor values which were stored
+   * in GetBasic().
+   */
+  void Process();
+
+  bool ReplayIGC(const TCHAR *path);
+  bool ReplayNMEA(const TCHAR *path);
+};
+
+void
+HeadlessReplay::Process()
+{
+  /* the sensor clock follows the replay time, so data expires just
+     as it would during the real flight */
+  basic.clock = basic.Time;
+  basic.Connected.Update(basic.clock);
+
+  {
+    ScopeTiming timer(timings.basic);
+    basic_computer.Fill(basic, settings.SettingsComputer());
+    basic_computer.Compute(basic, last, glide_computer.Calculated(),
+                           settings.SettingsComputer());
+  }
+
+  {
+    ScopeTiming timer(timings.gps);
+    glide_computer.ReadBlackboard(basic);
+    glide_computer.ProcessGPS();
+  }
+
+  /* ProcessGPS() decides about idle processing with the wall clock,
+     which is meaningless here; the CalculationThread runs it about
+     once per fix, and so do we */
+  {
+    ScopeTiming timer(timings.idle);
+    glide_computer.ProcessIdle();
+  }
+
+  if (negative(first_time))
+    first_time = basic.Time;
+  timings.flight_time = basic.Time - first_time;
+  ++timings.fixes;
+
+  last = basic;
+}
+
+bool
+HeadlessReplay::ReplayIGC(const TCHAR *path)
+{
+  FileLineReaderA reader(path);
+  if (reader.error())
+    return false;
+
+  BrokenDate date(2011, 6, 5);
+
+  while (true) {
+    IGCFix fix;
+    bool is_fix;
+
+    {
+      ScopeTiming timer(timings.parse);
+
+      const char *line = reader.read();
+      if (line == NULL)
+        break;
+
+      BrokenDate parsed_date;
+      is_fix = IGCParseFix(line, fix);
+      if (!is_fix && IGCParseDate(line, parsed_date))
+        date = parsed_date;
+    }
+
+    if (!is_fix)
+      continue;
+
+    basic.Time = fix.time;
+    basic.time_available.Update(fix.time);
+    basic.DateTime.year = date.year;
+    basic.DateTime.month = date.month;
+    basic.DateTime.day = date.day;
+    basic.DateTime.hour = (unsigned)(fix.time / 3600);
+    basic.DateTime.minute = (unsigned)(fix.time / 60) % 60;
+    basic.DateTime.second = (unsigned)fix.time % 60;
+
+    basic.Location = fix.location;
+    basic.LocationAvailable.Update(fix.time);
+    basic.GPSAltitude = fix.gps_altitude;
+    basic.GPSAltitudeAvailable.Update(fix.time);
+    basic.PressureAltitude = basic.BaroAltitude = fix.pressure_altitude;
+    basic.PressureAltitudeAvailable.Update(fix.time);
+    basic.BaroAltitudeAvailable.Update(fix.time);
+
+    Process();
+  }
+
+  return true;
+}
+
+bool
+HeadlessReplay::ReplayNMEA(const TCHAR *path)
+{
+  FileLineReaderA reader(path);
+  if (reader.error())
+    return false;
+
+  NMEAParser parser;
+  parser.SetReal(false);
+
+  while (true) {
+    bool is_rmc;
+
+    {
+      ScopeTiming timer(timings.parse);
+
+      const char *line = reader.read();
+      if (line == NULL)
+        break;
+
+      parser.ParseNMEAString_Internal(line, basic);
+
+      /* like NmeaReplay, one GPRMC sentence concludes a fix */
+      is_rmc = strncmp(line, "$GPRMC", 6) == 0;
+    }
+
+    if (is_rmc && basic.LocationAvailable)
+      Process();
+  }
+
+  return true;
+}
+
+static bool
+ReplayFile(const TCHAR *path, Airspaces &airspace_database,
+           ReplayTimings &total)
+{
+  HeadlessReplay replay(airspace_database);
+
+  const bool success = MatchesExtension(path, _T("igc"))
+    ? replay.ReplayIGC(path)
+    : replay.ReplayNMEA(path);
+  if (!success) {
+    _ftprintf(stderr, _T("Failed to open %s\n"), path);
+    return false;
+  }
+
+  _tprintf(_T("%s\n"), path);
+  replay.timings.Print();
+
+  total.Add(replay.timings);
+  return true;
+}
+
+/**
+ * Prints the timings of the stages inside the #GlideComputer, which
+ * were collected by #calculation_profiler.
+ */
+static void
+PrintCalculationProfile()
+{
+  printf("calculation stages (us): count mean p50 p95 p99 max\n");
+
+  for (unsigned i = 0; i < calculation_profiler.GetNumStages(); ++i) {
+    const TimingHistogram h = calculation_profiler.Get(i);
+    if (h.GetCount() == 0)
+      continue;
+
+    _tprintf(_T("  %-16s %8u %6u %6u %6u %6u %8u\n"),
+             calculation_profiler.GetName(i), h.GetCount(), h.GetMean(),
+             h.GetPercentile(50), h.GetPercentile(95),
+             h.GetPercentile(99), h.GetMax());
+  }
+}
+
+static bool
+LoadAirspace(const char *_path, Airspaces &airspace_database)
+{
+  PathName path(_path);
+  FileLineReader reader(path);
+  if (reader.error()) {
+    fprintf(stderr, "Failed to open %s\n", _path);
+    return false;
+  }
+
+  NullOperationEnvironment operation;
+  if (!ReadAirspace(airspace_database, reader, operation)) {
+    fprintf(stderr, "Failed to parse %s\n", _path);
+    return false;
+  }
+
+  airspace_database.optimise();
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  Airspaces airspace_database;
+
+  int i = 1;
+  if (i + 1 < argc && strcmp(argv[i], "-a") == 0) {
+    if (!LoadAirspace(argv[i + 1], airspace_database))
+      return EXIT_FAILURE;
+
+    i += 2;
+  }
+
+  if (i >= argc) {
+    fprintf(stderr, "Usage: %s [-a AIRSPACE.txt] FILE.igc|FILE.nmea ...\n",
+            argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  calculation_profiler.SetEnabled(true);
+
+  const unsigned start = MonotonicClockMS();
+
+  ReplayTimings total;
+  unsigned n_files = 0;
+  for (; i < argc; ++i) {
+    PathName path(argv[i]);
+    if (ReplayFile(path, airspace_database, total))
+      ++n_files;
+  }
+
+  const unsigned elapsed_ms = MonotonicClockMS() - start;
+
+  if (n_files > 1) {
+    printf("total: %u files in %u ms\n", n_files, elapsed_ms);
+    total.Print();
+  }
+
+  PrintCalculationProfile();
+
+  return n_files > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
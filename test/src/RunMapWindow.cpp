@@ -36,7 +36,7 @@ Copyright_License {
 #include "Profile/ProfileKeys.hpp"
 #include "LocalPath.hpp"
 #include "LocalTime.hpp"
-#include "WaypointGlue.hpp"
+#include "Waypoint/WaypointGlue.hpp"
 #include "Device/device.hpp"
 #include "Topography/TopographyStore.hpp"
 #include "Topography/TopographyGlue.hpp"
@@ -60,6 +60,12 @@ Copyright_License {
 #include "Look/TaskLook.hpp"
 #include "Look/AircraftLook.hpp"
 #include "Look/TrafficLook.hpp"
+#include "OS/PathName.hpp"
+#include "Navigation/Geometry/GeoVector.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #ifndef _MSC_VER
 #include <algorithm>
@@ -195,7 +201,7 @@ LoadFiles()
 
   terrain = RasterTerrain::OpenTerrain(NULL, operation);
 
-  WaypointGlue::LoadWaypoints(way_points, terrain, operation);
+  WaypointGlue::LoadWaypoints(way_points, terrain, NULL, operation);
 
   TLineReader *reader = OpenConfiguredTextFile(szProfileAirspaceFile);
   if (reader != NULL) {
@@ -255,8 +261,63 @@ public:
     map.UpdateAll();
     map.repaint();
   }
+
+  static void Benchmark(MapWindow &map, unsigned passes);
 };
 
+static void
+PrintSummary(const TCHAR *name, const MapRenderProfiler::Summary &summary)
+{
+  _tprintf(_T("  %-24s %8u %8u %8u %8u\n"), name,
+           summary.mean, summary.p50, summary.p95, summary.max);
+}
+
+/**
+ * Renders the map along a scripted sequence of zoom levels and pan
+ * offsets around the aircraft, and prints the frame and layer times.
+ * One pass of the script has exactly as many frames as the rolling
+ * window of #MapRenderProfiler, so each summary covers one pass.
+ */
+void
+DrawThread::Benchmark(MapWindow &map, unsigned passes)
+{
+  static const unsigned scales[] = {
+    1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000,
+  };
+  static const unsigned n_scales = sizeof(scales) / sizeof(scales[0]);
+  static const unsigned n_directions =
+    MapRenderProfiler::WINDOW_SIZE / n_scales;
+
+  const GeoPoint center = map.Basic().Location;
+  MapRenderProfiler &profiler = map.GetRenderProfiler();
+  profiler.SetEnabled(true);
+
+  for (unsigned pass = 0; pass < passes; ++pass) {
+    profiler.Reset();
+
+    for (unsigned i = 0; i < n_scales; ++i) {
+      map.SetMapScale(fixed(scales[i]));
+
+      for (unsigned j = 0; j < n_directions; ++j) {
+        const GeoVector offset(fixed(scales[i] / 4),
+                               Angle::degrees(fixed(j * 360 / n_directions)));
+        map.SetLocation(offset.end_point(center));
+
+        /* load terrain and topography before the clock starts, so
+           only rendering is measured */
+        map.UpdateAll();
+        map.repaint();
+      }
+    }
+
+    _tprintf(_T("pass %u (us): mean p50 p95 max\n"), pass + 1);
+    PrintSummary(_T("frame"), profiler.GetFrameSummary());
+    for (unsigned i = 0; i < MapRenderProfiler::NUM_LAYERS; ++i)
+      PrintSummary(MapRenderProfiler::GetLayerName(i),
+                   profiler.GetLayerSummary((MapRenderProfiler::Layer)i));
+  }
+}
+
 #endif
 
 #ifndef WIN32
@@ -272,6 +333,21 @@ WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
         int nCmdShow)
 #endif
 {
+#if !defined(WIN32) && !defined(ENABLE_OPENGL)
+  /* "--benchmark [PASSES [FILE.csv]]" renders a scripted sequence
+     of frames without showing the window */
+  unsigned benchmark_passes = 0;
+  const char *benchmark_csv = NULL;
+  if (argc >= 2 && strcmp(argv[1], "--benchmark") == 0) {
+    benchmark_passes = argc >= 3 ? atoi(argv[2]) : 1;
+    if (benchmark_passes == 0)
+      benchmark_passes = 1;
+
+    if (argc >= 4)
+      benchmark_csv = argv[3];
+  }
+#endif
+
   InitialiseDataPath();
   Profile::SetFiles(_T(""));
   Profile::Load();
@@ -315,9 +391,22 @@ WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
 #ifndef ENABLE_OPENGL
   DrawThread::Draw(window.map);
 #endif
-  window.show();
 
-  window.event_loop();
+#if !defined(WIN32) && !defined(ENABLE_OPENGL)
+  if (benchmark_passes > 0) {
+    if (benchmark_csv != NULL &&
+        !window.map.GetRenderProfiler().OpenCSV(PathName(benchmark_csv)))
+      fprintf(stderr, "Failed to create %s\n", benchmark_csv);
+
+    DrawThread::Benchmark(window.map, benchmark_passes);
+  } else {
+#endif
+    window.show();
+    window.event_loop();
+#if !defined(WIN32) && !defined(ENABLE_OPENGL)
+  }
+#endif
+
   window.reset();
 
   Fonts::Deinitialize();
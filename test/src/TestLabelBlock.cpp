@@ -0,0 +1,143 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Screen/LabelBlock.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+#include <stdlib.h>
+
+/**
+ * The trivial implementation which LabelBlock is compared with: check
+ * the new rectangle against every one added before.
+ */
+class NaiveLabelBlock {
+  std::vector<PixelRect> blocks;
+
+public:
+  bool check(const PixelRect rc) {
+    for (std::vector<PixelRect>::const_iterator i = blocks.begin(),
+           end = blocks.end(); i != end; ++i)
+      if (i->left < rc.right && i->right > rc.left &&
+          i->top < rc.bottom && i->bottom > rc.top)
+        return false;
+
+    blocks.push_back(rc);
+    return true;
+  }
+
+  void reset() {
+    blocks.clear();
+  }
+};
+
+static PixelRect
+MakeRect(int left, int top, int width, int height)
+{
+  PixelRect rc;
+  rc.left = left;
+  rc.top = top;
+  rc.right = left + width;
+  rc.bottom = top + height;
+  return rc;
+}
+
+/**
+ * Returns a random rectangle, mostly label sized, sometimes much
+ * larger, and sometimes partially or entirely outside of a 640x480
+ * screen.
+ */
+static PixelRect
+RandomRect()
+{
+  const int left = rand() % 1000 - 200;
+  const int top = rand() % 800 - 200;
+
+  int width, height;
+  if (rand() % 20 == 0) {
+    /* wider than the bucket grid */
+    width = 1000 + rand() % 1500;
+    height = 100 + rand() % 1500;
+  } else {
+    width = 1 + rand() % 150;
+    height = 1 + rand() % 40;
+  }
+
+  return MakeRect(left, top, width, height);
+}
+
+/**
+ * Feeds the same random rectangles to both implementations.
+ *
+ * @return the number of rectangles for which the results differ
+ */
+static unsigned
+CompareRandom(LabelBlock &block, NaiveLabelBlock &naive, unsigned n)
+{
+  unsigned mismatches = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    const PixelRect rc = RandomRect();
+    if (block.check(rc) != naive.check(rc))
+      ++mismatches;
+  }
+
+  return mismatches;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(14);
+
+  LabelBlock block;
+
+  /* rectangles crossing a bucket boundary collide in every bucket
+     they cover */
+  ok1(block.check(MakeRect(50, 50, 30, 30)));
+  ok1(!block.check(MakeRect(70, 10, 10, 50)));
+  ok1(!block.check(MakeRect(10, 70, 50, 10)));
+  ok1(block.check(MakeRect(80, 50, 10, 10)));
+
+  /* rectangles outside of the screen, wrapping around the grid */
+  ok1(block.check(MakeRect(-40, -40, 30, 30)));
+  ok1(!block.check(MakeRect(-20, -20, 5, 5)));
+  ok1(block.check(MakeRect(50 + 1024, 50 + 1024, 30, 30)));
+
+  /* a rectangle wider than the grid */
+  ok1(!block.check(MakeRect(-500, 55, 3000, 5)));
+  ok1(block.check(MakeRect(-500, 100, 3000, 5)));
+  ok1(!block.check(MakeRect(600, 102, 5, 5)));
+
+  block.reset();
+  ok1(block.check(MakeRect(50, 50, 30, 30)));
+  block.reset();
+
+  NaiveLabelBlock naive;
+  srand(42);
+  for (unsigned i = 0; i < 3; ++i) {
+    ok1(CompareRandom(block, naive, 500) == 0);
+    block.reset();
+    naive.reset();
+  }
+
+  return exit_status();
+}
@@ -0,0 +1,108 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/LockFreeFifo.hpp"
+#include "Thread/Thread.hpp"
+#include "OS/Sleep.h"
+#include "TestUtil.hpp"
+
+static const unsigned N = 20000;
+
+typedef LockFreeFifo<unsigned, 8> Fifo;
+
+class Producer : public Thread {
+  Fifo &fifo;
+
+public:
+  Producer(Fifo &_fifo):fifo(_fifo) {}
+
+protected:
+  virtual void Run() {
+    for (unsigned i = 0; i < N;) {
+      unsigned *slot = fifo.write();
+      if (slot == NULL) {
+        /* let the consumer run on single-core machines */
+        Sleep(0);
+        continue;
+      }
+
+      *slot = i++;
+      fifo.append();
+    }
+  }
+};
+
+int main(int argc, char **argv)
+{
+  plan_tests(12);
+
+  Fifo fifo;
+  ok1(fifo.read() == NULL);
+
+  *fifo.write() = 1;
+  fifo.append();
+  ok1(fifo.read() != NULL && *fifo.read() == 1);
+  fifo.consume();
+  ok1(fifo.read() == NULL);
+
+  /* fill it up: "size-1" items fit */
+  for (unsigned i = 0; i < 7; ++i) {
+    *fifo.write() = i;
+    fifo.append();
+  }
+  ok1(fifo.write() == NULL);
+  ok1(*fifo.read() == 0);
+  fifo.consume();
+  ok1(fifo.write() != NULL);
+
+  fifo.clear();
+  ok1(fifo.read() == NULL);
+  ok1(fifo.write() != NULL);
+
+  /* a concurrent producer must deliver all items in order */
+  Producer producer(fifo);
+  ok1(producer.Start());
+
+  bool in_order = true;
+  for (unsigned i = 0; i < N;) {
+    const unsigned *item = fifo.read();
+    if (item == NULL) {
+      Sleep(0);
+      continue;
+    }
+
+    if (*item != i)
+      in_order = false;
+
+    fifo.consume();
+    ++i;
+  }
+
+  producer.Join();
+
+  ok1(in_order);
+  ok1(fifo.read() == NULL);
+  ok1(fifo.write() != NULL);
+
+  return exit_status();
+}
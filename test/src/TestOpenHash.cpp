@@ -0,0 +1,96 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Util/OpenHash.hpp"
+#include "TestUtil.hpp"
+
+struct UnsignedHash {
+  unsigned operator()(unsigned x) const {
+    return open_hash_mix(x);
+  }
+};
+
+/** a bad hash function, to test collision handling */
+struct ConstantHash {
+  unsigned operator()(unsigned x) const {
+    return 0;
+  }
+};
+
+template<class Hash>
+static void
+TestSet()
+{
+  OpenHashSet<unsigned, Hash> set;
+  ok1(set.empty());
+  ok1(set.find(1) == set.NONE);
+
+  ok1(set.insert(1).second);
+  ok1(set.insert(2).second);
+  ok1(!set.insert(1).second);
+  ok1(set.size() == 2);
+  ok1(set.find(1) == 0);
+  ok1(set.find(2) == 1);
+  ok1(set.find(3) == set.NONE);
+
+  /* grow beyond the initial capacity; indices must remain valid */
+  bool all_found = true;
+  for (unsigned i = 3; i < 1000; ++i)
+    set.insert(i * 7);
+  for (unsigned i = 3; i < 1000; ++i)
+    all_found &= set[set.find(i * 7)] == i * 7;
+  ok1(all_found);
+  ok1(set.size() == 999);
+  ok1(set.find(1) == 0);
+
+  set.clear();
+  ok1(set.empty());
+  ok1(set.find(1) == set.NONE);
+  ok1(set.insert(1).second);
+}
+
+static void
+TestMap()
+{
+  OpenHashMap<unsigned, int, UnsignedHash> map(4);
+  ok1(map.insert(std::make_pair(10u, -1)).second);
+  ok1(map.insert(std::make_pair(20u, -2)).second);
+
+  std::pair<unsigned, bool> result = map.insert(std::make_pair(10u, -3));
+  ok1(!result.second);
+  ok1(map[result.first].second == -1);
+
+  map[result.first].second = -4;
+  ok1(map[map.find(10)].second == -4);
+  ok1(map[map.find(20)].second == -2);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(2 * 15 + 6);
+
+  TestSet<UnsignedHash>();
+  TestSet<ConstantHash>();
+  TestMap();
+
+  return exit_status();
+}
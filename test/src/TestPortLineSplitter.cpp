@@ -0,0 +1,98 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Device/PortLineSplitter.hpp"
+#include "TestUtil.hpp"
+
+#include <string>
+#include <vector>
+#include <string.h>
+
+class RecordingHandler : public Port::Handler {
+public:
+  std::vector<std::string> lines;
+
+  virtual void LineReceived(const char *line) {
+    lines.push_back(line);
+  }
+};
+
+static void
+Feed(PortLineSplitter &splitter, const char *data)
+{
+  splitter.DataReceived(data, strlen(data));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(13);
+
+  RecordingHandler handler;
+  PortLineSplitter splitter(handler);
+
+  /* several lines in one chunk, carriage returns stripped */
+  Feed(splitter, "$GPRMC,1\r\n$GPGGA,2\r\n");
+  ok1(handler.lines.size() == 2);
+  ok1(handler.lines[0] == "$GPRMC,1");
+  ok1(handler.lines[1] == "$GPGGA,2");
+
+  /* a line split over several chunks */
+  handler.lines.clear();
+  Feed(splitter, "$PFL");
+  Feed(splitter, "AU,3\r");
+  ok1(handler.lines.empty());
+  Feed(splitter, "\n$PGRMZ");
+  ok1(handler.lines.size() == 1);
+  ok1(handler.lines[0] == "$PFLAU,3");
+
+  /* the partial line is dropped by Clear() */
+  splitter.Clear();
+  Feed(splitter, "\n");
+  ok1(handler.lines.size() == 2);
+  ok1(handler.lines[1].empty());
+
+  /* an overlong line is discarded up to the next newline */
+  handler.lines.clear();
+  std::string big(300, 'x');
+  Feed(splitter, big.c_str());
+  Feed(splitter, "yyy\nok\n");
+  ok1(handler.lines.size() == 1);
+  ok1(handler.lines[0] == "ok");
+
+  /* a line which fills the buffer except for the terminator */
+  handler.lines.clear();
+  std::string fits(255, 'z');
+  fits += "\r\n";
+  Feed(splitter, fits.c_str());
+  ok1(handler.lines.size() == 1);
+  ok1(handler.lines[0].length() == 255);
+
+  /* one byte more does not fit */
+  handler.lines.clear();
+  std::string too_long(256, 'z');
+  too_long += "\n";
+  Feed(splitter, too_long.c_str());
+  ok1(handler.lines.empty());
+
+  return exit_status();
+}
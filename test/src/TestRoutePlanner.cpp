@@ -0,0 +1,209 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Route/TerrainRoute.hpp"
+#include "Terrain/RasterMap.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "Navigation/SpeedVector.hpp"
+#include "Navigation/Geometry/GeoVector.hpp"
+#include "Math/Earth.hpp"
+#include "OS/PathName.hpp"
+#include "Compatibility/path.h"
+#include "Operation.hpp"
+#include "TestUtil.hpp"
+
+static bool
+EqualRoutes(const Route &a, const Route &b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (unsigned i = 0; i < a.size(); ++i)
+    if (!(a[i] == b[i]) || a[i].altitude != b[i].altitude)
+      return false;
+
+  return true;
+}
+
+static void
+TestClearanceCache(const RasterMap &map)
+{
+  const GlidePolar polar(fixed_one);
+  const SpeedVector wind(Angle::degrees(fixed_zero), fixed_zero);
+
+  RoutePlannerConfig config;
+  config.mode = RoutePlannerConfig::rpTerrain;
+
+  const GeoPoint center = map.GetMapCenter();
+  GeoPoint p_aircraft(Angle::degrees(fixed(-0.3)), Angle::degrees(fixed_zero));
+  p_aircraft += center;
+  GeoPoint p_target(Angle::degrees(fixed(0.8)), Angle::degrees(fixed(-0.7)));
+  p_target += center;
+
+  const AGeoPoint aircraft(p_aircraft, map.GetHeight(p_aircraft) + 1500);
+  const short target_altitude = map.GetHeight(p_target) + 100;
+
+  /* like GlideComputerTask, derive the target from the vector to it,
+     which is slightly different from every location */
+  const AGeoPoint target(GeoVector(p_aircraft, p_target).end_point(p_aircraft),
+                         target_altitude);
+
+  TerrainRoute route(polar, wind);
+  route.set_terrain(&map);
+  ok1(route.solve(target, aircraft, config));
+  const unsigned long cached_first = route.get_count_terrain_cached();
+
+  /* the aircraft advanced by 300 m towards the target, and lost
+     some height on the way */
+  const AGeoPoint moved(FindLatitudeLongitude(p_aircraft,
+                                              p_aircraft.bearing(p_target),
+                                              fixed(300)),
+                        aircraft.altitude - 10);
+  const AGeoPoint moved_target(GeoVector(moved, p_target).end_point(moved),
+                               target_altitude);
+  ok1(!(moved_target == target));
+  ok1(route.solve(moved_target, moved, config));
+  ok1(route.get_count_terrain_cached() > cached_first);
+
+  /* the cached checks must not change the result; set_terrain()
+     drops them from the reference planner, but keeps its projection */
+  TerrainRoute fresh(polar, wind);
+  fresh.set_terrain(&map);
+  fresh.solve(target, aircraft, config);
+  fresh.set_terrain(&map);
+  fresh.solve(moved_target, moved, config);
+  Route expected, actual;
+  fresh.get_solution(expected);
+  route.get_solution(actual);
+  ok1(EqualRoutes(expected, actual));
+}
+
+static void
+TestReachSerial(const RasterMap &map)
+{
+  const GlidePolar polar(fixed_one);
+  const SpeedVector wind(Angle::degrees(fixed_zero), fixed_zero);
+
+  TerrainRoute route(polar, wind);
+  route.set_terrain(&map);
+
+  const GeoPoint center = map.GetMapCenter();
+  const AGeoPoint origin(center, map.GetHeight(center) + 1000);
+
+  route.solve_reach(origin);
+  const unsigned serial = route.get_reach_serial();
+
+  /* same origin and polar: the fan is kept */
+  route.update_polar(polar, polar, wind);
+  ok1(route.solve_reach(origin));
+  ok1(route.get_reach_serial() == serial);
+
+  /* a different wind changes the arrival heights */
+  const SpeedVector wind2(Angle::degrees(fixed(90)), fixed(10));
+  route.update_polar(polar, polar, wind2);
+  ok1(route.get_reach_serial() != serial);
+
+  const unsigned serial2 = route.get_reach_serial();
+  const AGeoPoint lower(center, origin.altitude - 10);
+  ok1(route.solve_reach(lower));
+  ok1(route.get_reach_serial() != serial2);
+}
+
+/**
+ * Runs the jobs backwards on the calling thread, to show that the
+ * order of the rays doesn't matter.
+ */
+class ReverseRunner : public ParallelRunner {
+public:
+  virtual void ForEach(Job &job, unsigned n) {
+    while (n > 0)
+      job.Run(--n);
+  }
+};
+
+static void
+TestReachRunner(const RasterMap &map)
+{
+  const GlidePolar polar(fixed_one);
+  const SpeedVector wind(Angle::degrees(fixed_zero), fixed_zero);
+
+  const GeoPoint center = map.GetMapCenter();
+  const AGeoPoint origin(center, map.GetHeight(center) + 1000);
+
+  TerrainRoute serial(polar, wind);
+  serial.set_terrain(&map);
+  serial.solve_reach(origin);
+
+  ReverseRunner runner;
+  TerrainRoute parallel(polar, wind);
+  parallel.set_terrain(&map);
+  parallel.set_reach_runner(&runner);
+  parallel.solve_reach(origin);
+
+  bool equal = true;
+  for (int i = -10; i <= 10; ++i) {
+    for (int j = -10; j <= 10; ++j) {
+      GeoPoint p(Angle::degrees(fixed(i) / 20),
+                 Angle::degrees(fixed(j) / 20));
+      p += center;
+      const AGeoPoint dest(p, map.GetHeight(p));
+
+      short a_reach, a_direct, b_reach, b_direct;
+      serial.find_positive_arrival(dest, a_reach, a_direct);
+      parallel.find_positive_arrival(dest, b_reach, b_direct);
+      if (a_reach != b_reach || a_direct != b_direct)
+        equal = false;
+    }
+  }
+  ok1(equal);
+}
+
+int main(int argc, char **argv)
+{
+  const char *path = argc > 1 ? argv[1] : "test/data/benalla9.xcm";
+
+  TCHAR jp2_path[4096];
+  _tcscpy(jp2_path, PathName(path));
+  _tcscat(jp2_path, _T(DIR_SEPARATOR_S) _T("terrain.jp2"));
+
+  TCHAR j2w_path[4096];
+  _tcscpy(j2w_path, PathName(path));
+  _tcscat(j2w_path, _T(DIR_SEPARATOR_S) _T("terrain.j2w"));
+
+  NullOperationEnvironment operation;
+  RasterMap map(jp2_path, j2w_path, NULL, operation);
+  if (!map.isMapLoaded()) {
+    fprintf(stderr, "Failed to load terrain from %s\n", path);
+    return EXIT_FAILURE;
+  }
+
+  do {
+    map.SetViewCenter(map.GetMapCenter(), fixed(100000));
+  } while (map.IsDirty());
+
+  plan_tests(11);
+  TestClearanceCache(map);
+  TestReachSerial(map);
+  TestReachRunner(map);
+  return exit_status();
+}
@@ -0,0 +1,119 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "StageProfiler.hpp"
+#include "TestUtil.hpp"
+
+static void
+TestEmpty()
+{
+  TimingHistogram h;
+  ok1(h.GetCount() == 0);
+  ok1(h.GetMax() == 0);
+  ok1(h.GetMean() == 0);
+  ok1(h.GetPercentile(50) == 0);
+  ok1(h.GetPercentile(100) == 0);
+}
+
+static void
+TestSingle()
+{
+  TimingHistogram h;
+  h.Add(100);
+  ok1(h.GetCount() == 1);
+  ok1(h.GetLast() == 100);
+  ok1(h.GetMax() == 100);
+  ok1(h.GetMean() == 100);
+
+  /* the bucket reaches up to 127, but there is no such sample */
+  ok1(h.GetPercentile(0) == 100);
+  ok1(h.GetPercentile(50) == 100);
+  ok1(h.GetPercentile(100) == 100);
+}
+
+static void
+TestTopBucket()
+{
+  /* samples beyond the range of the buckets end up in the last one,
+     which has no upper bound but the largest sample */
+  TimingHistogram h;
+  h.Add(1);
+  h.Add(1u << 30);
+  ok1(h.GetCount() == 2);
+  ok1(h.GetMax() == 1u << 30);
+  ok1(h.GetPercentile(50) == 1);
+  ok1(h.GetPercentile(100) == 1u << 30);
+
+  h.Reset();
+  ok1(h.GetCount() == 0);
+  ok1(h.GetPercentile(100) == 0);
+}
+
+static void
+TestDistribution()
+{
+  /* 1..100: the buckets end at 1, 3, 7, 15, 31, 63 and 127 */
+  TimingHistogram h;
+  for (unsigned i = 1; i <= 100; ++i)
+    h.Add(i);
+
+  ok1(h.GetCount() == 100);
+  ok1(h.GetLast() == 100);
+  ok1(h.GetMean() == 50);
+  ok1(h.GetPercentile(10) == 15);
+  ok1(h.GetPercentile(50) == 63);
+  ok1(h.GetPercentile(63) == 63);
+  ok1(h.GetPercentile(64) == 100);
+  ok1(h.GetPercentile(95) == 100);
+}
+
+static void
+TestProfiler()
+{
+  static const TCHAR *const names[] = { _T("a"), _T("b") };
+  StageProfiler profiler(names, 2);
+  ok1(!profiler.IsEnabled());
+  ok1(profiler.GetNumStages() == 2);
+
+  profiler.Add(1, 42);
+  profiler.Add(1, 8);
+  ok1(profiler.Get(0).GetCount() == 0);
+  ok1(profiler.Get(1).GetCount() == 2);
+  ok1(profiler.Get(1).GetMax() == 42);
+
+  profiler.Reset();
+  ok1(profiler.Get(1).GetCount() == 0);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(32);
+
+  TestEmpty();
+  TestSingle();
+  TestTopBucket();
+  TestDistribution();
+  TestProfiler();
+
+  return exit_status();
+}
@@ -22,6 +22,7 @@
 
 #include "Waypoint/WaypointReader.hpp"
 #include "Waypoint/WaypointReaderBase.hpp"
+#include "Waypoint/WaypointCache.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Units/Units.hpp"
@@ -30,6 +31,7 @@
 #include "Operation.hpp"
 
 #include <vector>
+#include <stdio.h>
 
 static void
 TestExtractParameters()
@@ -380,6 +382,47 @@ TestOzi(wp_vector org_wp)
   }
 }
 
+static bool
+CompareIds(const Waypoints &a, const Waypoints &b)
+{
+  for (unsigned id = 1; id <= a.size(); ++id) {
+    const Waypoint *wp_a = a.lookup_id(id), *wp_b = b.lookup_id(id);
+    if (wp_a == NULL || wp_b == NULL || wp_a->Name != wp_b->Name)
+      return false;
+  }
+
+  return true;
+}
+
+static void
+TestCache(wp_vector org_wp)
+{
+  Waypoints parsed;
+  if (!TestWaypointFile(_T("test/data/waypoints.cup"), parsed,
+                        org_wp.size())) {
+    skip(4 + 10 * org_wp.size(), 0, "opening waypoint file failed");
+    return;
+  }
+
+  FILE *file = tmpfile();
+  ok1(WaypointCache::Save(file, parsed, 0));
+  rewind(file);
+
+  Waypoints way_points;
+  ok1(WaypointCache::Load(file, way_points, 0));
+  fclose(file);
+  way_points.optimise();
+
+  ok1(way_points.size() == parsed.size());
+  ok1(CompareIds(parsed, way_points));
+
+  wp_vector::iterator it;
+  for (it = org_wp.begin(); it < org_wp.end(); it++) {
+    const Waypoint *wp = GetWaypoint(*it, way_points);
+    TestSeeYouWaypoint(*it, wp);
+  }
+}
+
 static wp_vector
 CreateOriginalWaypoints()
 {
@@ -477,7 +520,7 @@ int main(int argc, char **argv)
 {
   wp_vector org_wp = CreateOriginalWaypoints();
 
-  plan_tests(63 + 6 * 4 + (9 + 10 + 8 + 3 + 3 + 3) * org_wp.size());
+  plan_tests(63 + 7 * 4 + 4 + (9 + 10 + 8 + 3 + 3 + 3 + 10) * org_wp.size());
 
   TestExtractParameters();
 
@@ -487,6 +530,7 @@ int main(int argc, char **argv)
   TestFS(org_wp);
   TestFS_UTM(org_wp);
   TestOzi(org_wp);
+  TestCache(org_wp);
 
   return exit_status();
 }
@@ -0,0 +1,70 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2011 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Math/WindowStatistics.hpp"
+#include "TestUtil.hpp"
+
+int main(int argc, char **argv)
+{
+  plan_tests(22);
+
+  WindowStatistics<4> window;
+  ok1(window.empty());
+  ok1(window.size() == 0);
+  ok1(equals(window.GetAverage(), 0));
+  ok1(equals(window.GetSlope(), 0));
+
+  window.push(fixed(2));
+  ok1(!window.empty());
+  ok1(window.size() == 1);
+  ok1(equals(window.GetMinimum(), 2));
+  ok1(equals(window.GetMaximum(), 2));
+
+  window.push(fixed(4));
+  window.push(fixed(6));
+  ok1(window.size() == 3);
+  ok1(equals(window.GetSum(), 12));
+  ok1(equals(window.GetAverage(), 4));
+  ok1(equals(window.GetSlope(), 2));
+
+  /* the window is full; this evicts the minimum */
+  window.push(fixed(-1));
+  ok1(window.size() == 3);
+  ok1(equals(window.GetSum(), 9));
+  ok1(equals(window.GetMinimum(), -1));
+  ok1(equals(window.GetMaximum(), 6));
+  ok1(equals(window.GetSlope(), -2.5));
+
+  /* evicts an interior value, then the maximum */
+  window.push(fixed(3));
+  window.push(fixed(1));
+  ok1(equals(window.GetMaximum(), 3));
+  ok1(equals(window.GetMinimum(), -1));
+  ok1(equals(window.GetSlope(), 1));
+
+  window.clear();
+  ok1(window.empty());
+  ok1(window.size() == 0);
+
+  return exit_status();
+}
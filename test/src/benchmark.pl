@@ -0,0 +1,91 @@
+#!/usr/bin/perl
+#
+# Runs a benchmark program and compares its timings with a baseline.
+#
+# Usage: benchmark.pl [--update] [--tolerance=PERCENT] BASELINE PROGRAM [ARGS...]
+#
+# The program prints one line per benchmark: "NAME RUNS MEDIAN_US
+# MIN_US RESULT"; lines starting with '#' are comments.  With
+# --update, the output is written to BASELINE.  Otherwise, this
+# script fails if a benchmark's fastest run is more than PERCENT
+# slower than the baseline, or if its result differs.  The fastest
+# run is compared because it is least disturbed by other processes.
+
+use warnings;
+use strict;
+use Getopt::Long qw(:config require_order);
+
+my $update = 0;
+my $tolerance = 10;
+GetOptions('update' => \$update, 'tolerance=f' => \$tolerance)
+    or die "Usage: $0 [--update] [--tolerance=PERCENT] BASELINE PROGRAM [ARGS...]\n";
+
+my $baseline_path = shift @ARGV;
+die "Usage: $0 [--update] [--tolerance=PERCENT] BASELINE PROGRAM [ARGS...]\n"
+    unless defined $baseline_path and @ARGV;
+
+sub parse_line($) {
+    my $line = shift;
+    return if $line =~ /^\s*(#|$)/;
+    my ($name, $runs, $median, $min, $result) = split ' ', $line;
+    return unless defined $result;
+    return ($name, { runs => $runs, median => $median, min => $min,
+                     result => $result });
+}
+
+open my $program, '-|', @ARGV or die "Failed to run $ARGV[0]: $!\n";
+my @lines = <$program>;
+close $program or die "$ARGV[0] failed\n";
+
+if ($update) {
+    open my $out, '>', $baseline_path
+        or die "Failed to create $baseline_path: $!\n";
+    print $out @lines;
+    close $out;
+    print @lines;
+    exit 0;
+}
+
+my %baseline;
+if (open my $in, '<', $baseline_path) {
+    while (<$in>) {
+        my ($name, $b) = parse_line($_);
+        $baseline{$name} = $b if defined $name;
+    }
+    close $in;
+} else {
+    print "# no baseline in $baseline_path, run \"make benchmark-baseline\"\n";
+}
+
+my $failed = 0;
+printf "# %-20s %10s %10s %8s  %s\n", 'name', 'min_us', 'baseline', 'delta', 'status';
+foreach my $line (@lines) {
+    my ($name, $b) = parse_line($line);
+    next unless defined $name;
+
+    my $base = $baseline{$name};
+    unless (defined $base) {
+        printf "%-22s %10u %10s %8s  new\n", $name, $b->{min}, '-', '-';
+        next;
+    }
+
+    my $delta = $base->{min} > 0
+        ? 100.0 * ($b->{min} - $base->{min}) / $base->{min}
+        : 0;
+
+    my $status = 'ok';
+    if ($b->{result} ne $base->{result}) {
+        $status = "CHANGED result $base->{result} -> $b->{result}";
+        $failed = 1;
+    } elsif ($delta > $tolerance) {
+        $status = 'SLOWER';
+        $failed = 1;
+    } elsif ($delta < -$tolerance) {
+        $status = 'faster';
+    }
+
+    printf "%-22s %10u %10u %+7.1f%%  %s\n", $name, $b->{min},
+        $base->{min}, $delta, $status;
+}
+
+exit $failed;
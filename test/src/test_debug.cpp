@@ -23,7 +23,6 @@
 #include "test_debug.hpp"
 #include "harness_task.hpp"
 #include "harness_flight.hpp"
-#include "Task/Tasks/PathSolvers/ContestDijkstra.hpp"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -66,9 +65,6 @@ void distance_counts() {
       printf("#     dijkstra links/q %d\n", (unsigned)(count_dijkstra_links/count_dijkstra_queries));
     }
 #endif
-    printf("#     count_olc_solve %d\n", (int)ContestDijkstra::count_olc_solve);
-    printf("#     count_olc_trace %d\n", (int)ContestDijkstra::count_olc_trace);
-    printf("#     count_olc_size %d\n",ContestDijkstra::count_olc_size);
     printf("#    (total cycles %d)\n#\n",n_samples);
 #ifdef INSTRUMENT_ZERO
     if (zero_total) {
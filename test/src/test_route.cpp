@@ -30,6 +30,7 @@
 #include "GlideSolvers/GlidePolar.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "OS/PathName.hpp"
+#include "OS/Clock.hpp"
 #include "Compatibility/path.h"
 #include "Operation.hpp"
 
@@ -123,6 +124,8 @@ bool test_route(const unsigned n_airspaces, const RasterMap& map)
     config.mode = RoutePlannerConfig::rpBoth;
 
     bool sol = false;
+    unsigned long expanded = 0;
+    const unsigned t_start = MonotonicClockMS();
     for (int i=0; i<NUM_SOL; i++) {
       loc_end.Latitude+= Angle::degrees(fixed(0.1));
       loc_end.altitude = map.GetHeight(loc_end)+100;
@@ -138,10 +141,15 @@ bool test_route(const unsigned n_airspaces, const RasterMap& map)
         }
         sol = false;
       }
+      expanded += route.get_count_expanded();
       char buffer[80];
       sprintf(buffer,"route %d solution", i);
       ok(sol, buffer, 0);
     }
+    const unsigned t_elapsed = MonotonicClockMS() - t_start;
+    printf("# %d solutions, %lu nodes expanded in %u ms (%lu nodes/s)\n",
+           NUM_SOL, expanded, t_elapsed,
+           expanded * 1000 / std::max(t_elapsed, 1u));
   }
 
   delete airspaces; airspaces = NULL;
@@ -158,7 +166,7 @@ int main(int argc, char** argv)
     return 0;
   }
 
-  const char hc_path[] = "tmp/terrain";
+  const char hc_path[] = "test/data/benalla9.xcm";
 
   TCHAR jp2_path[4096];
   _tcscpy(jp2_path, PathName(hc_path));
@@ -175,7 +175,7 @@ int main(int argc, char** argv)
     return 0;
   }
 
-  plan_tests(14);
+  plan_tests(15);
 
   Waypoints waypoints;
 
@@ -185,6 +185,8 @@ int main(int argc, char** argv)
 
   ok(test_lookup(waypoints,3),"waypoint lookup",0);
   ok(!test_lookup(waypoints,5000),"waypoint bad lookup",0);
+  ok(waypoints.set_home(4) && waypoints.GetHome() == waypoints.lookup_id(4),
+     "waypoint set home",0);
   ok(test_nearest(waypoints),"waypoint nearest",0);
   ok(test_nearest_landable(waypoints),"waypoint nearest landable",0);
   ok(test_location(waypoints,true),"waypoint location good",0);